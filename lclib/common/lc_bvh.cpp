@@ -0,0 +1,130 @@
+#include "lc_global.h"
+#include "lc_bvh.h"
+#include <atomic>
+
+// Leaf bounds are grown slightly so items lying on a face of their box are
+// still found by ray tests that are computed with different rounding.
+constexpr float lcBoundingBoxTreeEpsilon = 0.01f;
+
+// Pieces load asynchronously, so their boxes can change on a loader thread.
+static std::atomic<quint64> lcPickGeneration(1);
+
+quint64 lcGetPickGeneration()
+{
+	return lcPickGeneration.load(std::memory_order_acquire);
+}
+
+void lcPickBoxesChanged()
+{
+	lcPickGeneration.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void lcBoundingBoxTree::Clear()
+{
+	mNodes.clear();
+	mItems.clear();
+}
+
+void lcBoundingBoxTree::Build(const std::vector<lcBoundingBox>& Boxes, int LeafSize)
+{
+	Clear();
+
+	if (Boxes.empty())
+		return;
+
+	const int Count = static_cast<int>(Boxes.size());
+
+	mItems.resize(Count);
+
+	for (int ItemIdx = 0; ItemIdx < Count; ItemIdx++)
+		mItems[ItemIdx] = ItemIdx;
+
+	mNodes.reserve(2 * (Count / std::max(LeafSize, 1)) + 1);
+	mNodes.emplace_back();
+
+	BuildNode(0, 0, Count, Boxes, std::max(LeafSize, 1), 0);
+}
+
+void lcBoundingBoxTree::BuildNode(int NodeIndex, int First, int Count, const std::vector<lcBoundingBox>& Boxes, int LeafSize, int Depth)
+{
+	lcBoundingBoxTreeNode& Node = mNodes[NodeIndex];
+
+	Node.First = First;
+	Node.Count = Count;
+	UpdateLeafBounds(Node, Boxes);
+
+	if (Count <= LeafSize || Depth >= LC_BVH_MAX_DEPTH - 1)
+		return;
+
+	lcVector3 CenterMin(FLT_MAX, FLT_MAX, FLT_MAX);
+	lcVector3 CenterMax(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+	for (int ItemIdx = First; ItemIdx < First + Count; ItemIdx++)
+	{
+		const lcBoundingBox& Box = Boxes[mItems[ItemIdx]];
+		const lcVector3 Center = (Box.Min + Box.Max) * 0.5f;
+
+		CenterMin = lcMin(CenterMin, Center);
+		CenterMax = lcMax(CenterMax, Center);
+	}
+
+	const lcVector3 Extent = CenterMax - CenterMin;
+	const int Axis = (Extent[0] > Extent[1] && Extent[0] > Extent[2]) ? 0 : (Extent[1] > Extent[2]) ? 1 : 2;
+	const int Half = Count / 2;
+
+	std::nth_element(mItems.begin() + First, mItems.begin() + First + Half, mItems.begin() + First + Count, [&Boxes, Axis](int Item1, int Item2)
+	{
+		return Boxes[Item1].Min[Axis] + Boxes[Item1].Max[Axis] < Boxes[Item2].Min[Axis] + Boxes[Item2].Max[Axis];
+	});
+
+	const int ChildIndex = static_cast<int>(mNodes.size());
+
+	mNodes.emplace_back();
+	mNodes.emplace_back();
+
+	mNodes[NodeIndex].First = ChildIndex;
+	mNodes[NodeIndex].Count = 0;
+
+	BuildNode(ChildIndex, First, Half, Boxes, LeafSize, Depth + 1);
+	BuildNode(ChildIndex + 1, First + Half, Count - Half, Boxes, LeafSize, Depth + 1);
+}
+
+void lcBoundingBoxTree::UpdateLeafBounds(lcBoundingBoxTreeNode& Node, const std::vector<lcBoundingBox>& Boxes) const
+{
+	Node.Min = lcVector3(FLT_MAX, FLT_MAX, FLT_MAX);
+	Node.Max = lcVector3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+	for (int ItemIdx = Node.First; ItemIdx < Node.First + Node.Count; ItemIdx++)
+	{
+		const lcBoundingBox& Box = Boxes[mItems[ItemIdx]];
+
+		Node.Min = lcMin(Node.Min, Box.Min);
+		Node.Max = lcMax(Node.Max, Box.Max);
+	}
+
+	const lcVector3 Epsilon(lcBoundingBoxTreeEpsilon, lcBoundingBoxTreeEpsilon, lcBoundingBoxTreeEpsilon);
+
+	Node.Min -= Epsilon;
+	Node.Max += Epsilon;
+}
+
+// Updates the node bounds after items moved without changing the tree layout.
+// Children are always stored after their parent so a reverse pass sees them first.
+void lcBoundingBoxTree::Refit(const std::vector<lcBoundingBox>& Boxes)
+{
+	for (auto NodeIt = mNodes.rbegin(); NodeIt != mNodes.rend(); ++NodeIt)
+	{
+		lcBoundingBoxTreeNode& Node = *NodeIt;
+
+		if (Node.Count)
+			UpdateLeafBounds(Node, Boxes);
+		else
+		{
+			const lcBoundingBoxTreeNode& Child1 = mNodes[Node.First];
+			const lcBoundingBoxTreeNode& Child2 = mNodes[Node.First + 1];
+
+			Node.Min = lcMin(Child1.Min, Child2.Min);
+			Node.Max = lcMax(Child1.Max, Child2.Max);
+		}
+	}
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "lc_math.h"
+
+#define LC_BVH_MAX_DEPTH 64
+
+// Bounding volume hierarchy over a list of axis aligned boxes. Picking uses it
+// to find the pieces or mesh triangles a ray or selection volume can touch
+// without testing every one of them.
+
+struct lcBoundingBoxTreeNode
+{
+	lcVector3 Min;
+	lcVector3 Max;
+	int First; // first child for inner nodes, the second child follows it; first item for leaves
+	int Count; // number of items in a leaf, zero for inner nodes
+};
+
+class lcBoundingBoxTree
+{
+public:
+	void Build(const std::vector<lcBoundingBox>& Boxes, int LeafSize);
+	void Refit(const std::vector<lcBoundingBox>& Boxes);
+	void Clear();
+
+	bool IsEmpty() const
+	{
+		return mNodes.empty();
+	}
+
+	// Calls Callback(Item) for the items in every leaf the ray from Start
+	// through End enters, nearest leaves first. Nodes entered beyond
+	// *MaxDistance are skipped when MaxDistance is set; it may be lowered
+	// by the callback. Traversal stops when the callback returns true.
+	template<typename CallbackType>
+	void RayTest(const lcVector3& Start, const lcVector3& End, const float* MaxDistance, CallbackType Callback) const
+	{
+		if (mNodes.empty())
+			return;
+
+		float Distance;
+		int Stack[LC_BVH_MAX_DEPTH * 2];
+		int StackSize = 0;
+
+		if (!lcBoundingBoxRayIntersectDistance(mNodes[0].Min, mNodes[0].Max, Start, End, &Distance, nullptr, nullptr) || (MaxDistance && Distance > *MaxDistance))
+			return;
+
+		Stack[StackSize++] = 0;
+
+		while (StackSize)
+		{
+			const lcBoundingBoxTreeNode& Node = mNodes[Stack[--StackSize]];
+
+			if (Node.Count)
+			{
+				for (int ItemIdx = Node.First; ItemIdx < Node.First + Node.Count; ItemIdx++)
+					if (Callback(mItems[ItemIdx]))
+						return;
+
+				continue;
+			}
+
+			float ChildDistance[2];
+			bool ChildHit[2];
+
+			for (int ChildIdx = 0; ChildIdx < 2; ChildIdx++)
+			{
+				const lcBoundingBoxTreeNode& Child = mNodes[Node.First + ChildIdx];
+				ChildHit[ChildIdx] = lcBoundingBoxRayIntersectDistance(Child.Min, Child.Max, Start, End, &ChildDistance[ChildIdx], nullptr, nullptr) && (!MaxDistance || ChildDistance[ChildIdx] <= *MaxDistance);
+			}
+
+			// Push the farther child first so the nearer one is visited next.
+			const int Near = (ChildHit[0] && ChildHit[1] && ChildDistance[1] < ChildDistance[0]) ? 1 : 0;
+
+			if (ChildHit[Near ^ 1])
+				Stack[StackSize++] = Node.First + (Near ^ 1);
+
+			if (ChildHit[Near])
+				Stack[StackSize++] = Node.First + Near;
+		}
+	}
+
+	// Calls Callback(Item) for the items in every leaf that is not entirely
+	// outside one of the planes. Traversal stops when the callback returns true.
+	template<typename CallbackType>
+	void PlanesTest(const lcVector4 Planes[6], CallbackType Callback) const
+	{
+		if (mNodes.empty())
+			return;
+
+		int Stack[LC_BVH_MAX_DEPTH * 2];
+		int StackSize = 0;
+
+		Stack[StackSize++] = 0;
+
+		while (StackSize)
+		{
+			const lcBoundingBoxTreeNode& Node = mNodes[Stack[--StackSize]];
+
+			if (IsOutsidePlanes(Node, Planes))
+				continue;
+
+			if (Node.Count)
+			{
+				for (int ItemIdx = Node.First; ItemIdx < Node.First + Node.Count; ItemIdx++)
+					if (Callback(mItems[ItemIdx]))
+						return;
+
+				continue;
+			}
+
+			Stack[StackSize++] = Node.First + 1;
+			Stack[StackSize++] = Node.First;
+		}
+	}
+
+protected:
+	void BuildNode(int NodeIndex, int First, int Count, const std::vector<lcBoundingBox>& Boxes, int LeafSize, int Depth);
+	void UpdateLeafBounds(lcBoundingBoxTreeNode& Node, const std::vector<lcBoundingBox>& Boxes) const;
+
+	static bool IsOutsidePlanes(const lcBoundingBoxTreeNode& Node, const lcVector4 Planes[6])
+	{
+		// A point is outside a plane when Dot(Point, Plane) + Plane.w > 0, the
+		// box is outside if its corner nearest to the inside is outside.
+		for (int PlaneIdx = 0; PlaneIdx < 6; PlaneIdx++)
+		{
+			const lcVector4& Plane = Planes[PlaneIdx];
+			const lcVector3 Corner(Plane[0] > 0.0f ? Node.Min[0] : Node.Max[0], Plane[1] > 0.0f ? Node.Min[1] : Node.Max[1], Plane[2] > 0.0f ? Node.Min[2] : Node.Max[2]);
+
+			if (lcDot3(Corner, Plane) + Plane[3] > 0.0f)
+				return true;
+		}
+
+		return false;
+	}
+
+	std::vector<lcBoundingBoxTreeNode> mNodes;
+	std::vector<int> mItems;
+};
+
+// Counts changes to the pick boxes of all pieces. Adding, removing, moving or
+// reshaping a piece bumps it, picking trees built for an older generation
+// must be refreshed before they are used.
+quint64 lcGetPickGeneration();
+void lcPickBoxesChanged();
@@ -564,6 +564,11 @@ public:
 		return mFile.open(Flags);
 	}
 
+	const quint8* Map()
+	{
+		return mFile.map(0, mFile.size());
+	}
+
 protected:
 	QFile mFile;
 };
@@ -13,6 +13,7 @@
 #include <QPrinter>
 #include <QPrintDialog>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <array>
 #include <set>
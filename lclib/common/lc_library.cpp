@@ -30,9 +30,15 @@
 #  define DEF_MEM_LEVEL	 MAX_MEM_LEVEL
 #endif
 
-#define LC_LIBRARY_CACHE_VERSION   0x0110
+#define LC_LIBRARY_CACHE_VERSION   0x0112
 #define LC_LIBRARY_CACHE_ARCHIVE   0x0001
 #define LC_LIBRARY_CACHE_DIRECTORY 0x0002
+/*** LPub3D Mod - packed mesh cache ***/
+#define LC_LIBRARY_CACHE_PACKED    0x0004
+/*** LPub3D Mod end ***/
+/*** LPub3D Mod - stud style meshes ***/
+#define LC_LIBRARY_CACHE_ANY_STUD_STYLE -1
+/*** LPub3D Mod end ***/
 /*** LPub3D Mod - part types ***/
 #define LC_LIBRARY_PART_TYPE       1
 /*** LPub3D Mod end ***/
@@ -59,6 +65,11 @@ lcPiecesLibrary::lcPiecesLibrary()
 	mCancelLoading = false;
 	mStudStyle = static_cast<lcStudStyle>(lcGetProfileInt(LC_PROFILE_STUD_STYLE));
 	mStudCylinderColorEnabled = lcGetProfileInt(LC_PROFILE_STUD_CYLINDER_COLOR_ENABLED);
+/*** LPub3D Mod - packed mesh cache ***/
+	mPackedMeshCache = lcGetProfileInt(LC_PROFILE_PACKED_MESH_CACHE);
+	mPackedCacheData = nullptr;
+	memset(mArchiveCheckSum, 0, sizeof(mArchiveCheckSum));
+/*** LPub3D Mod end ***/
 }
 
 lcPiecesLibrary::~lcPiecesLibrary()
@@ -75,6 +86,10 @@ lcPiecesLibrary::~lcPiecesLibrary()
 
 void lcPiecesLibrary::Unload()
 {
+/*** LPub3D Mod - packed mesh cache ***/
+	SavePackedCache();
+/*** LPub3D Mod end ***/
+
 	for (const auto& PieceIt : mPieces)
 		delete PieceIt.second;
 	mPieces.clear();
@@ -301,6 +316,10 @@ bool lcPiecesLibrary::Load(const QString& LibraryPath, bool ShowProgress)
 			return false;
 	}
 
+/*** LPub3D Mod - packed mesh cache ***/
+	OpenPackedCache();
+/*** LPub3D Mod end ***/
+
 	UpdateStudStyleSource();
 	lcLoadDefaultCategories();
 	lcSynthInit();
@@ -614,6 +633,21 @@ bool lcPiecesLibrary::OpenDirectory(const QDir& LibraryDir, bool ShowProgress)
 /*** LPub3D Mod ***/
 	ReadDirectoryDescriptions(FileLists, ShowProgress);
 
+	// cached meshes are only valid while no part or primitive file has been added, removed or modified,
+	// each file adds its modification time and size to an order independent stamp
+	qint64 NumFiles = 0;
+	quint64 FileStamp = 0;
+
+	auto AddFileStamp = [&NumFiles, &FileStamp](const QFileInfo& FileInfo)
+	{
+		NumFiles++;
+		FileStamp += (quint64)FileInfo.lastModified().toMSecsSinceEpoch() * 0x9E3779B97F4A7C15ULL ^ (quint64)FileInfo.size();
+	};
+
+	for (const QFileInfoList& FileList : FileLists)
+		for (const QFileInfo& FileInfo : FileList)
+			AddFileStamp(FileInfo);
+
 	for (unsigned int BaseFolderIdx = 0; BaseFolderIdx < LC_ARRAY_COUNT(BaseFolders); BaseFolderIdx++)
 	{
 		std::unique_ptr<lcLibrarySource> Source(new lcLibrarySource);
@@ -667,6 +701,8 @@ bool lcPiecesLibrary::OpenDirectory(const QDir& LibraryDir, bool ShowProgress)
 					mHasUnofficialDirectory = true;
 /*** LPub3D Mod ***/
 
+				AddFileStamp(DirIterator.fileInfo());
+
 				const bool SubFile = SubFileDirectories[DirectoryIdx];
 				Source->Primitives[Name] = new lcLibraryPrimitive(std::move(FileName), strchr(FileString, '/') + 1, lcZipFileType::Count, 0, !SubFile && IsStudPrimitive(Name), IsStudStylePrimitive(Name), SubFile);
 			}
@@ -675,6 +711,11 @@ bool lcPiecesLibrary::OpenDirectory(const QDir& LibraryDir, bool ShowProgress)
 		mSources.emplace_back(std::move(Source));
 	}
 
+	mArchiveCheckSum[0] = NumFiles;
+	mArchiveCheckSum[1] = (qint64)FileStamp;
+	mArchiveCheckSum[2] = qHash(LibraryDir.absolutePath());
+	mArchiveCheckSum[3] = LC_LIBRARY_CACHE_DIRECTORY;
+
 	for (unsigned int BaseFolderIdx = 0; BaseFolderIdx < LC_ARRAY_COUNT(BaseFolders); BaseFolderIdx++)
 	{
 		QDir BaseDir(LibraryDir.absoluteFilePath(QLatin1String(BaseFolders[BaseFolderIdx])));
@@ -1194,19 +1235,51 @@ bool lcPiecesLibrary::SaveArchiveCacheIndex(const QString& FileName)
 	return WriteArchiveCacheFile(FileName, IndexFile);
 }
 
-bool lcPiecesLibrary::LoadCachePiece(PieceInfo* Info)
+/*** LPub3D Mod - stud style meshes ***/
+/*
+ * Meshes without style studs are cached once under the piece name for
+ * every stud style. Meshes with style studs are cached per stud style
+ * under the piece name followed by the style key so each style variant
+ * stays in the cache when the style changes.
+ */
+
+bool lcPiecesLibrary::ReadCachePiece(const char* FileName, lcMemFile& CacheFile, qint32& Flags)
 {
-	QString FileName = QFileInfo(QDir(mCachePath), QString::fromLatin1(Info->mFileName)).absoluteFilePath();
-	lcMemFile MeshData;
+	if (!ReadPackedCachePiece(FileName, CacheFile))
+	{
+		QString CacheFileName = QFileInfo(QDir(mCachePath), QString::fromLatin1(FileName)).absoluteFilePath();
 
-	if (!ReadArchiveCacheFile(FileName, MeshData))
-		return false;
+		if (!ReadArchiveCacheFile(CacheFileName, CacheFile))
+			return false;
+	}
 
+	return CacheFile.ReadBuffer((char*)&Flags, sizeof(Flags)) != 0;
+}
+
+QByteArray lcPiecesLibrary::GetStudStyleCacheName(const PieceInfo* Info) const
+{
+	return QByteArray(Info->mFileName) + '@' + QByteArray::number(GetStudStyleKey());
+}
+/*** LPub3D Mod end ***/
+
+bool lcPiecesLibrary::LoadCachePiece(PieceInfo* Info, const QFileInfo& PieceFileInfo)
+{
+	lcMemFile MeshData;
+
+/*** LPub3D Mod - stud style meshes ***/
 	qint32 Flags;
-	if (MeshData.ReadBuffer((char*)&Flags, sizeof(Flags)) == 0)
+
+	if (!ReadCachePiece(Info->mFileName, MeshData, Flags) || Flags != LC_LIBRARY_CACHE_ANY_STUD_STYLE)
+		if (!ReadCachePiece(GetStudStyleCacheName(Info).constData(), MeshData, Flags) || Flags != GetStudStyleKey())
+			return false;
+/*** LPub3D Mod end ***/
+
+	// size and modification time of loose part files, zero for archive parts
+	qint64 FileStamp[2];
+	if (MeshData.ReadBuffer((char*)&FileStamp, sizeof(FileStamp)) == 0)
 		return false;
 
-	if (Flags != static_cast<qint32>(mStudStyle) + static_cast<qint32>(mStudCylinderColorEnabled))
+	if (FileStamp[0] != (PieceFileInfo.exists() ? PieceFileInfo.size() : 0) || FileStamp[1] != (PieceFileInfo.exists() ? PieceFileInfo.lastModified().toMSecsSinceEpoch() : 0))
 		return false;
 
 	lcMesh* Mesh = new lcMesh;
@@ -1222,30 +1295,206 @@ bool lcPiecesLibrary::LoadCachePiece(PieceInfo* Info)
 	}
 }
 
-bool lcPiecesLibrary::SaveCachePiece(PieceInfo* Info)
+bool lcPiecesLibrary::SaveCachePiece(PieceInfo* Info, const QFileInfo& PieceFileInfo)
 {
 	lcMemFile MeshData;
 
-	const qint32 Flags = static_cast<qint32>(mStudStyle) + static_cast<qint32>(mStudCylinderColorEnabled);
+/*** LPub3D Mod - stud style meshes ***/
+	const bool StyleStud = Info->GetMesh()->mFlags.testFlag(lcMeshFlag::HasStyleStud);
+	const QByteArray CacheName = StyleStud ? GetStudStyleCacheName(Info) : QByteArray(Info->mFileName);
+
+	const qint32 Flags = StyleStud ? GetStudStyleKey() : LC_LIBRARY_CACHE_ANY_STUD_STYLE;
+/*** LPub3D Mod end ***/
 	if (MeshData.WriteBuffer((char*)&Flags, sizeof(Flags)) == 0)
 		return false;
 
+	const qint64 FileStamp[2] = { PieceFileInfo.exists() ? PieceFileInfo.size() : 0, PieceFileInfo.exists() ? PieceFileInfo.lastModified().toMSecsSinceEpoch() : 0 };
+	if (MeshData.WriteBuffer((char*)&FileStamp, sizeof(FileStamp)) == 0)
+		return false;
+
 	if (!Info->GetMesh()->FileSave(MeshData))
 		return false;
 
-	QString FileName = QFileInfo(QDir(mCachePath), QString::fromLatin1(Info->mFileName)).absoluteFilePath();
+/*** LPub3D Mod - packed mesh cache ***/
+	if (mPackedMeshCache)
+	{
+		QMutexLocker PackedLock(&mPackedCacheMutex);
+		mPackedPending[CacheName.toStdString()] = QByteArray((const char*)MeshData.mBuffer, (int)MeshData.GetLength());
+	}
+/*** LPub3D Mod end ***/
+
+/*** LPub3D Mod - stud style meshes ***/
+	QString FileName = QFileInfo(QDir(mCachePath), QString::fromLatin1(CacheName)).absoluteFilePath();
+/*** LPub3D Mod end ***/
 
 	return WriteArchiveCacheFile(FileName, MeshData);
 }
 
-class lcSleeper : public QThread
+/*** LPub3D Mod - packed mesh cache ***/
+/*
+ * The packed cache holds the cache data of every part mesh in one
+ * uncompressed file that is memory mapped when the library loads:
+ * version, flags, library checksum, entry count, then an entry table of
+ * null terminated file names with the offset and size of their data.
+ */
+
+constexpr qint64 lcPackedCacheHeaderSize = sizeof(quint32) * 3 + sizeof(qint64) * 4;
+
+void lcPiecesLibrary::OpenPackedCache()
 {
-public:
-	static void msleep(unsigned long Msecs)
+	if (!mPackedMeshCache)
+		return;
+
+	QMutexLocker PackedLock(&mPackedCacheMutex);
+
+	std::unique_ptr<QFile> File(new QFile(QFileInfo(QDir(mCachePath), QLatin1String("meshes.pack")).absoluteFilePath()));
+
+	if (!File->open(QIODevice::ReadOnly) || File->size() < lcPackedCacheHeaderSize)
+		return;
+
+	const quint64 DataSize = File->size();
+	const uchar* Data = File->map(0, DataSize);
+
+	if (!Data)
+		return;
+
+	quint32 Header[3];
+	qint64 CacheCheckSum[4];
+
+	memcpy(Header, Data, sizeof(Header));
+	memcpy(CacheCheckSum, Data + sizeof(Header), sizeof(CacheCheckSum));
+
+	if (Header[0] != LC_LIBRARY_CACHE_VERSION || Header[1] != LC_LIBRARY_CACHE_PACKED || memcmp(CacheCheckSum, mArchiveCheckSum, sizeof(CacheCheckSum)))
+		return;
+
+	const uchar* Entry = Data + lcPackedCacheHeaderSize;
+	const uchar* End = Data + DataSize;
+
+	mPackedMeshes.reserve(Header[2]);
+
+	for (quint32 EntryIdx = 0; EntryIdx < Header[2]; EntryIdx++)
 	{
-		QThread::msleep(Msecs);
+		const char* Name = (const char*)Entry;
+		const size_t NameLength = strnlen(Name, End - Entry);
+		quint64 Location[2];
+
+		if (Entry + NameLength + 1 + sizeof(Location) > End)
+		{
+			mPackedMeshes.clear();
+			return;
+		}
+
+		Entry += NameLength + 1;
+		memcpy(Location, Entry, sizeof(Location));
+		Entry += sizeof(Location);
+
+		if (Location[0] + Location[1] > DataSize)
+		{
+			mPackedMeshes.clear();
+			return;
+		}
+
+		mPackedMeshes.emplace(std::string(Name, NameLength), std::make_pair(Location[0], Location[1]));
 	}
-};
+
+	mPackedCacheFile = std::move(File);
+	mPackedCacheData = Data;
+}
+
+// Pieces load on worker threads while SavePackedCache may replace the mapping.
+bool lcPiecesLibrary::ReadPackedCachePiece(const char* FileName, lcMemFile& CacheFile)
+{
+	QMutexLocker PackedLock(&mPackedCacheMutex);
+
+	if (!mPackedCacheData)
+		return false;
+
+	const auto EntryIt = mPackedMeshes.find(FileName);
+
+	if (EntryIt == mPackedMeshes.end())
+		return false;
+
+	const quint64 Offset = EntryIt->second.first;
+	const quint64 Size = EntryIt->second.second;
+
+	CacheFile.SetLength(Size);
+	CacheFile.Seek(0, SEEK_SET);
+	CacheFile.WriteBuffer(mPackedCacheData + Offset, Size);
+	CacheFile.Seek(0, SEEK_SET);
+
+	return true;
+}
+
+// Merges the meshes cached during this session into the packed cache and closes it.
+void lcPiecesLibrary::SavePackedCache()
+{
+	QMutexLocker PackedLock(&mPackedCacheMutex);
+
+	std::map<std::string, QByteArray> Meshes = std::move(mPackedPending);
+	mPackedPending.clear();
+
+	if (!Meshes.empty() && mPackedCacheData)
+		for (const auto& [Name, Location] : mPackedMeshes)
+			Meshes.emplace(Name, QByteArray((const char*)mPackedCacheData + Location.first, (int)Location.second));
+
+	mPackedMeshes.clear();
+	mPackedCacheData = nullptr;
+	mPackedCacheFile.reset();
+
+	if (!mPackedMeshCache || Meshes.empty())
+		return;
+
+	quint64 Offset = lcPackedCacheHeaderSize;
+
+	for (const auto& [Name, Data] : Meshes)
+		Offset += Name.size() + 1 + sizeof(quint64) * 2;
+
+	QSaveFile File(QFileInfo(QDir(mCachePath), QLatin1String("meshes.pack")).absoluteFilePath());
+
+	if (!File.open(QIODevice::WriteOnly))
+		return;
+
+	const quint32 Header[3] = { LC_LIBRARY_CACHE_VERSION, LC_LIBRARY_CACHE_PACKED, (quint32)Meshes.size() };
+
+	File.write((const char*)Header, sizeof(Header));
+	File.write((const char*)mArchiveCheckSum, sizeof(mArchiveCheckSum));
+
+	for (const auto& [Name, Data] : Meshes)
+	{
+		const quint64 Location[2] = { Offset, (quint64)Data.size() };
+
+		File.write(Name.c_str(), Name.size() + 1);
+		File.write((const char*)Location, sizeof(Location));
+		Offset += Data.size();
+	}
+
+	for (const auto& [Name, Data] : Meshes)
+		File.write(Data);
+
+	File.commit();
+}
+/*** LPub3D Mod end ***/
+
+// Blocks until another thread has finished loading a piece or primitive.
+// mLoadWaitCount counts the waits so contention can be measured.
+void lcPiecesLibrary::WaitForLoad(const std::function<bool()>& Loading)
+{
+	QMutexLocker WaitLock(&mLoadWaitMutex);
+
+	if (!Loading())
+		return;
+
+	mLoadWaitCount.ref();
+
+	while (Loading())
+		mLoadWaitCondition.wait(&mLoadWaitMutex);
+}
+
+void lcPiecesLibrary::NotifyLoadFinished()
+{
+	QMutexLocker WaitLock(&mLoadWaitMutex);
+	mLoadWaitCondition.wakeAll();
+}
 
 void lcPiecesLibrary::LoadPieceInfo(PieceInfo* Info, bool Wait, bool Priority)
 {
@@ -1260,14 +1509,17 @@ void lcPiecesLibrary::LoadPieceInfo(PieceInfo* Info, bool Wait, bool Priority)
 			if (Info->mState == lcPieceInfoState::Unloaded)
 			{
 				Info->Load();
+				NotifyLoadFinished();
 				emit PartLoaded(Info);
 			}
 			else
 			{
 				LoadLock.unlock();
 
-				while (Info->mState != lcPieceInfoState::Loaded)
-					lcSleeper::msleep(10);
+				WaitForLoad([Info]()
+				{
+					return Info->mState != lcPieceInfoState::Loaded;
+				});
 			}
 		}
 	}
@@ -1315,7 +1567,10 @@ void lcPiecesLibrary::LoadQueuedPiece()
 	mLoadMutex.unlock();
 
 	if (Info)
+	{
 		Info->Load();
+		NotifyLoadFinished();
+	}
 
 	emit PartLoaded(Info);
 }
@@ -1334,6 +1589,7 @@ bool lcPiecesLibrary::LoadPieceData(PieceInfo* Info)
 
 	bool Loaded = false;
 	bool SaveCache = false;
+	QFileInfo PieceFileInfo;
 
 	if (Info->mZipFileType != lcZipFileType::Count && mZipFiles[static_cast<int>(Info->mZipFileType)])
 	{
@@ -1353,6 +1609,18 @@ bool lcPiecesLibrary::LoadPieceData(PieceInfo* Info)
 		lcDiskFile PieceFile;
 
 /*** LPub3D Mod - parts load order ***/
+		for (const char* Folder : { (mPreferOfficialParts ? "parts" : "unofficial/parts"), (mPreferOfficialParts ? "unofficial/parts" : "parts") })
+		{
+			sprintf(FileName, "%s/%s", Folder, Info->mFileName);
+			PieceFileInfo.setFile(mLibraryDir.absoluteFilePath(QLatin1String(FileName)));
+
+			if (PieceFileInfo.exists())
+				break;
+		}
+
+		if (PieceFileInfo.exists() && LoadCachePiece(Info, PieceFileInfo))
+			return true;
+
 		if (mPreferOfficialParts ? true : mHasUnofficialDirectory)
 		{
 			sprintf(FileName, "%s/%s", (mPreferOfficialParts ? "parts" : "unofficial/parts"), Info->mFileName);
@@ -1371,6 +1639,8 @@ bool lcPiecesLibrary::LoadPieceData(PieceInfo* Info)
 			if (PieceFile.Open(QIODevice::ReadOnly))
 				Loaded = MeshLoader.LoadMesh(PieceFile, LC_MESHDATA_SHARED);
 		}
+
+		SaveCache = Loaded && PieceFileInfo.exists();
 	}
 
 	if (mCancelLoading)
@@ -1389,7 +1659,7 @@ bool lcPiecesLibrary::LoadPieceData(PieceInfo* Info)
 	}
 
 	if (SaveCache)
-		SaveCachePiece(Info);
+		SaveCachePiece(Info, PieceFileInfo);
 
 	return Loaded;
 }
@@ -1686,6 +1956,10 @@ void lcPiecesLibrary::SetStudStyle(lcStudStyle StudStyle, bool Reload, bool Stud
 	if (mStudStyle == StudStyle && mStudCylinderColorEnabled == StudCylinderColorEnabled)
 		return;
 
+/*** LPub3D Mod - stud style meshes ***/
+	const int OldStyleKey = GetStudStyleKey();
+/*** LPub3D Mod end ***/
+
 	mStudStyle = StudStyle;
 
 	mStudCylinderColorEnabled = StudCylinderColorEnabled;
@@ -1710,6 +1984,11 @@ void lcPiecesLibrary::SetStudStyle(lcStudStyle StudStyle, bool Reload, bool Stud
 
 	if (Reload)
 	{
+/*** LPub3D Mod - stud style meshes ***/
+		const int StyleKey = GetStudStyleKey();
+		std::vector<PieceInfo*> SwappedPieces;
+/*** LPub3D Mod end ***/
+
 		mLoadMutex.lock();
 
 		for (const auto& PieceIt : mPieces)
@@ -1718,7 +1997,18 @@ void lcPiecesLibrary::SetStudStyle(lcStudStyle StudStyle, bool Reload, bool Stud
 
 			if (Info->mState == lcPieceInfoState::Loaded && Info->GetMesh() && Info->GetMesh()->mFlags & lcMeshFlag::HasStyleStud)
 			{
-				Info->Unload();
+/*** LPub3D Mod - stud style meshes ***/
+				if (!Info->IsModel() && !Info->IsProject())
+				{
+					if (Info->SwapStudStyleMesh(OldStyleKey, StyleKey))
+					{
+						SwappedPieces.push_back(Info);
+						continue;
+					}
+				}
+				else
+					Info->Unload();
+/*** LPub3D Mod end ***/
 				mLoadQueue.append(Info);
 				mLoadFutures.append(QtConcurrent::run([this]() { LoadQueuedPiece(); }));
 			}
@@ -1727,6 +2017,11 @@ void lcPiecesLibrary::SetStudStyle(lcStudStyle StudStyle, bool Reload, bool Stud
 		mLoadMutex.unlock();
 
 		WaitForLoadQueue();
+
+/*** LPub3D Mod - stud style meshes ***/
+		for (PieceInfo* Info : SwappedPieces)
+			emit PartLoaded(Info);
+/*** LPub3D Mod end ***/
 	}
 }
 
@@ -1762,14 +2057,35 @@ bool lcPiecesLibrary::LoadPrimitive(lcLibraryPrimitive* Primitive)
 	{
 		mLoadMutex.unlock();
 
-		while (Primitive->mState == lcPrimitiveState::Loading)
-			lcSleeper::msleep(5);
+		WaitForLoad([Primitive]()
+		{
+			return Primitive->mState == lcPrimitiveState::Loading;
+		});
 
 		return Primitive->mState == lcPrimitiveState::Loaded;
 	}
 
 	mLoadMutex.unlock();
 
+	const bool Loaded = LoadPrimitiveMesh(Primitive);
+
+	if (Loaded)
+		Primitive->mMeshData.ReleaseVertexGrids();
+
+	mLoadMutex.lock();
+	if (Loaded)
+		Primitive->mState = lcPrimitiveState::Loaded;
+	else
+		Primitive->Unload();
+	mLoadMutex.unlock();
+
+	NotifyLoadFinished();
+
+	return Loaded;
+}
+
+bool lcPiecesLibrary::LoadPrimitiveMesh(lcLibraryPrimitive* Primitive)
+{
 	lcMeshLoader MeshLoader(Primitive->mMeshData, true, nullptr, false);
 
 	if (mZipFiles[static_cast<int>(lcZipFileType::Official)])
@@ -1832,10 +2148,6 @@ bool lcPiecesLibrary::LoadPrimitive(lcLibraryPrimitive* Primitive)
 		}
 	}
 
-	mLoadMutex.lock();
-	Primitive->mState = lcPrimitiveState::Loaded;
-	mLoadMutex.unlock();
-
 	return true;
 }
 
@@ -116,7 +116,7 @@ struct lcLibrarySource
 	lcLibrarySource& operator=(lcLibrarySource&&) = delete;
 
 	lcLibrarySourceType Type;
-	std::map<std::string, lcLibraryPrimitive*> Primitives;
+	std::unordered_map<std::string, lcLibraryPrimitive*> Primitives;
 };
 
 class lcPiecesLibrary : public QObject
@@ -164,6 +164,8 @@ public:
 	bool LoadPieceData(PieceInfo* Info);
 	void LoadQueuedPiece();
 	void WaitForLoadQueue();
+	void WaitForLoad(const std::function<bool()>& Loading);
+	void NotifyLoadFinished();
 
 	lcTexture* FindTexture(const char* TextureName, Project* CurrentProject, bool SearchProjectFolder);
 	bool LoadTexture(lcTexture* Texture);
@@ -184,6 +186,7 @@ public:
 	bool IsPrimitive(const char* Name) const;
 	lcLibraryPrimitive* FindPrimitive(const char* Name) const;
 	bool LoadPrimitive(lcLibraryPrimitive* Primitive);
+	bool LoadPrimitiveMesh(lcLibraryPrimitive* Primitive);
 
 	bool SupportsStudStyle() const;
 	void SetStudStyle(lcStudStyle StudStyle, bool Reload, bool StudCylinderColorEnabled);
@@ -211,6 +214,11 @@ public:
 		return mCancelLoading;
 	}
 
+	int GetLoadWaitCount() const
+	{
+		return mLoadWaitCount;
+	}
+
 	void UpdateBuffers(lcContext* Context);
 	void UnloadUnusedParts();
 
@@ -240,10 +248,24 @@ protected:
 	bool WriteArchiveCacheFile(const QString& FileName, lcMemFile& CacheFile);
 	bool LoadCacheIndex(const QString& FileName);
 	bool SaveArchiveCacheIndex(const QString& FileName);
-	bool LoadCachePiece(PieceInfo* Info);
-	bool SaveCachePiece(PieceInfo* Info);
+	bool LoadCachePiece(PieceInfo* Info, const QFileInfo& PieceFileInfo = QFileInfo());
+	bool SaveCachePiece(PieceInfo* Info, const QFileInfo& PieceFileInfo = QFileInfo());
 	bool ReadDirectoryCacheFile(const QString& FileName, lcMemFile& CacheFile);
 	bool WriteDirectoryCacheFile(const QString& FileName, lcMemFile& CacheFile);
+/*** LPub3D Mod - packed mesh cache ***/
+	void OpenPackedCache();
+	void SavePackedCache();
+	bool ReadPackedCachePiece(const char* FileName, lcMemFile& CacheFile);
+/*** LPub3D Mod end ***/
+/*** LPub3D Mod - stud style meshes ***/
+	bool ReadCachePiece(const char* FileName, lcMemFile& CacheFile, qint32& Flags);
+	QByteArray GetStudStyleCacheName(const PieceInfo* Info) const;
+
+	int GetStudStyleKey() const
+	{
+		return static_cast<int>(mStudStyle) | (mStudCylinderColorEnabled ? 0x100 : 0);
+	}
+/*** LPub3D Mod end ***/
 
 	static bool IsStudPrimitive(const char* FileName);
 	static bool IsStudStylePrimitive(const char* FileName);
@@ -260,6 +282,9 @@ protected:
 #endif
 	QList<QFuture<void>> mLoadFutures;
 	QList<PieceInfo*> mLoadQueue;
+	QMutex mLoadWaitMutex;
+	QWaitCondition mLoadWaitCondition;
+	QAtomicInt mLoadWaitCount;
 
 	QMutex mTextureMutex;
 
@@ -273,6 +298,14 @@ bool mPreferOfficialParts;
 	QString mCachePath;
 	qint64 mArchiveCheckSum[4];
 	std::unique_ptr<lcZipFile> mZipFiles[static_cast<int>(lcZipFileType::Count)];
+/*** LPub3D Mod - packed mesh cache ***/
+	bool mPackedMeshCache;
+	std::unique_ptr<QFile> mPackedCacheFile;
+	const uchar* mPackedCacheData;
+	std::unordered_map<std::string, std::pair<quint64, quint64>> mPackedMeshes;
+	std::map<std::string, QByteArray> mPackedPending;
+	QMutex mPackedCacheMutex;
+/*** LPub3D Mod end ***/
 /*** LPub3D Mod - parts load order ***/
 	bool mHasUnofficialDirectory;
 /*** LPub3D Mod - ***/
@@ -180,6 +180,26 @@ bool lcMesh::MinIntersectDist(const lcVector3& Start, const lcVector3& End, floa
 	bool Hit = false;
 	lcVector3 Intersection;
 
+/*** LPub3D Mod - picking tree ***/
+	if (UpdateTriangleTree())
+	{
+		mTriangleTree.RayTest(Start, End, &MinDistance, [this, &Start, &End, &MinDistance, &Intersection, &Hit](int TriangleIdx)
+		{
+			const lcVector3* Triangle = &mTriangleTreeVertices[TriangleIdx * 3];
+
+			if (lcLineTriangleMinIntersection(Triangle[0], Triangle[1], Triangle[2], Start, End, &MinDistance, &Intersection))
+				Hit = true;
+
+			return false;
+		});
+
+		if (Hit)
+			HitPlane = IntersectionPlane;
+
+		return Hit;
+	}
+/*** LPub3D Mod end ***/
+
 	for (int SectionIdx = 0; SectionIdx < mLods[LC_MESH_LOD_HIGH].NumSections; SectionIdx++)
 	{
 		const lcMeshSection* Section = &mLods[LC_MESH_LOD_HIGH].Sections[SectionIdx];
@@ -233,6 +253,24 @@ bool lcMesh::MinIntersectDist(const lcVector3& Start, const lcVector3& End, floa
 template<typename IndexType>
 bool lcMesh::IntersectsPlanes(const lcVector4 (&Planes)[6])
 {
+/*** LPub3D Mod - picking tree ***/
+	if (UpdateTriangleTree())
+	{
+		bool Intersects = false;
+
+		mTriangleTree.PlanesTest(Planes, [this, &Planes, &Intersects](int TriangleIdx)
+		{
+			const lcVector3* Triangle = &mTriangleTreeVertices[TriangleIdx * 3];
+
+			Intersects = lcTriangleIntersectsPlanes(Triangle[0], Triangle[1], Triangle[2], Planes);
+
+			return Intersects;
+		});
+
+		return Intersects;
+	}
+/*** LPub3D Mod end ***/
+
 	for (int SectionIdx = 0; SectionIdx < mLods[LC_MESH_LOD_HIGH].NumSections; SectionIdx++)
 	{
 		const lcMeshSection* Section = &mLods[LC_MESH_LOD_HIGH].Sections[SectionIdx];
@@ -268,6 +306,86 @@ bool lcMesh::IntersectsPlanes(const lcVector4 (&Planes)[6])
 		return IntersectsPlanes<GLuint>(Planes);
 }
 
+/*** LPub3D Mod - picking tree ***/
+// Meshes with fewer triangles are tested directly, the tree costs more than it saves.
+#define LC_MESH_TRIANGLE_TREE_MIN  64
+#define LC_MESH_TRIANGLE_TREE_LEAF 4
+
+// Copies the high detail triangles into a flat list and builds a bounding
+// volume hierarchy over them so ray and volume tests only visit the
+// triangles near the pick instead of the whole mesh.
+template<typename IndexType>
+void lcMesh::BuildTriangleTree()
+{
+	int NumTriangles = 0;
+
+	for (int SectionIdx = 0; SectionIdx < mLods[LC_MESH_LOD_HIGH].NumSections; SectionIdx++)
+	{
+		const lcMeshSection* Section = &mLods[LC_MESH_LOD_HIGH].Sections[SectionIdx];
+
+		if (Section->PrimitiveType == LC_MESH_TRIANGLES || Section->PrimitiveType == LC_MESH_TEXTURED_TRIANGLES)
+			NumTriangles += Section->NumIndices / 3;
+	}
+
+	if (NumTriangles < LC_MESH_TRIANGLE_TREE_MIN)
+		return;
+
+	mTriangleTreeVertices.reserve(NumTriangles * 3);
+
+	for (int SectionIdx = 0; SectionIdx < mLods[LC_MESH_LOD_HIGH].NumSections; SectionIdx++)
+	{
+		const lcMeshSection* Section = &mLods[LC_MESH_LOD_HIGH].Sections[SectionIdx];
+		const IndexType* Indices = (IndexType*)mIndexData + Section->IndexOffset / sizeof(IndexType);
+
+		if (Section->PrimitiveType == LC_MESH_TRIANGLES)
+		{
+			const lcVertex* Verts = GetVertexData();
+
+			for (int Idx = 0; Idx < Section->NumIndices - Section->NumIndices % 3; Idx++)
+				mTriangleTreeVertices.emplace_back(Verts[Indices[Idx]].Position);
+		}
+		else if (Section->PrimitiveType == LC_MESH_TEXTURED_TRIANGLES)
+		{
+			const lcVertexTextured* Verts = GetTexturedVertexData();
+
+			for (int Idx = 0; Idx < Section->NumIndices - Section->NumIndices % 3; Idx++)
+				mTriangleTreeVertices.emplace_back(Verts[Indices[Idx]].Position);
+		}
+	}
+
+	std::vector<lcBoundingBox> Boxes(mTriangleTreeVertices.size() / 3);
+
+	for (size_t TriangleIdx = 0; TriangleIdx < Boxes.size(); TriangleIdx++)
+	{
+		const lcVector3* Triangle = &mTriangleTreeVertices[TriangleIdx * 3];
+
+		Boxes[TriangleIdx].Min = lcMin(lcMin(Triangle[0], Triangle[1]), Triangle[2]);
+		Boxes[TriangleIdx].Max = lcMax(lcMax(Triangle[0], Triangle[1]), Triangle[2]);
+	}
+
+	mTriangleTree.Build(Boxes, LC_MESH_TRIANGLE_TREE_LEAF);
+}
+
+// Builds the triangle tree the first time the mesh is picked, returns false
+// if the mesh is too small to use one.
+bool lcMesh::UpdateTriangleTree()
+{
+	QMutexLocker TreeLock(&mTriangleTreeMutex);
+
+	if (!mTriangleTreeBuilt)
+	{
+		if (mIndexType == GL_UNSIGNED_SHORT)
+			BuildTriangleTree<GLushort>();
+		else
+			BuildTriangleTree<GLuint>();
+
+		mTriangleTreeBuilt = true;
+	}
+
+	return !mTriangleTree.IsEmpty();
+}
+/*** LPub3D Mod end ***/
+
 template<typename IndexType>
 void lcMesh::ExportPOVRay(lcFile& File, const char* MeshName, const char** ColorTable)
 {
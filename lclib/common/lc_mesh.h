@@ -1,6 +1,9 @@
 #pragma once
 
 #include "lc_math.h"
+/*** LPub3D Mod - picking tree ***/
+#include "lc_bvh.h"
+/*** LPub3D Mod end ***/
 
 enum lcMeshPrimitiveType
 {
@@ -104,6 +107,12 @@ public:
 
 	int GetLodIndex(float Distance) const;
 
+/*** LPub3D Mod - picking tree ***/
+	template<typename IndexType>
+	void BuildTriangleTree();
+	bool UpdateTriangleTree();
+/*** LPub3D Mod end ***/
+
 	const lcVertex* GetVertexData() const
 	{
 		return static_cast<lcVertex*>(mVertexData);
@@ -135,4 +144,12 @@ public:
 	int mNumTexturedVertices = 0;
 	int mConditionalVertexCount = 0;
 	int mIndexType = 0;
+
+/*** LPub3D Mod - picking tree ***/
+protected:
+	lcBoundingBoxTree mTriangleTree;
+	std::vector<lcVector3> mTriangleTreeVertices;
+	bool mTriangleTreeBuilt = false;
+	QMutex mTriangleTreeMutex;
+/*** LPub3D Mod end ***/
 };
@@ -153,6 +153,69 @@ static bool lcCompareVertices(const lcVector3& Position1, const lcVector3& Posit
 	return fabsf(Position1.x - Position2.x) < lcDistanceEpsilon && fabsf(Position1.y - Position2.y) < lcDistanceEpsilon && fabsf(Position1.z - Position2.z) < lcDistanceEpsilon;
 }
 
+static inline qint32 lcVertexGridCell(float Value)
+{
+	return static_cast<qint32>(floor(static_cast<double>(Value) / lcDistanceEpsilon));
+}
+
+static inline quint64 lcVertexGridKey(qint32 x, qint32 y, qint32 z)
+{
+	return (static_cast<quint64>(x & 0x1fffff) << 42) | (static_cast<quint64>(y & 0x1fffff) << 21) | static_cast<quint64>(z & 0x1fffff);
+}
+
+// Returns the last vertex that lcCompareVertices matches and Match accepts, the same
+// vertex a backwards scan of mVertices finds. Vertices are bucketed in cells of
+// lcDistanceEpsilon so every candidate lies in the 27 cells around Position.
+template<typename MatchType>
+int lcMeshLoaderTypeData::FindVertex(const lcVector3& Position, MatchType Match)
+{
+	if (mGridVertexCount > mVertices.size())
+	{
+		mVertexGrid.clear();
+		mGridVertexCount = 0;
+	}
+
+	for (; mGridVertexCount < mVertices.size(); mGridVertexCount++)
+	{
+		const lcVector3& VertexPosition = mVertices[mGridVertexCount].Position;
+		mVertexGrid[lcVertexGridKey(lcVertexGridCell(VertexPosition.x), lcVertexGridCell(VertexPosition.y), lcVertexGridCell(VertexPosition.z))].emplace_back(static_cast<quint32>(mGridVertexCount));
+	}
+
+	const qint32 x = lcVertexGridCell(Position.x);
+	const qint32 y = lcVertexGridCell(Position.y);
+	const qint32 z = lcVertexGridCell(Position.z);
+	int Found = -1;
+
+	for (qint32 dx = -1; dx <= 1; dx++)
+	{
+		for (qint32 dy = -1; dy <= 1; dy++)
+		{
+			for (qint32 dz = -1; dz <= 1; dz++)
+			{
+				const auto CellIt = mVertexGrid.find(lcVertexGridKey(x + dx, y + dy, z + dz));
+
+				if (CellIt == mVertexGrid.end())
+					continue;
+
+				const std::vector<quint32>& Cell = CellIt->second;
+
+				for (auto IndexIt = Cell.rbegin(); IndexIt != Cell.rend() && static_cast<int>(*IndexIt) > Found; IndexIt++)
+				{
+					const lcMeshLoaderVertex& Vertex = mVertices[*IndexIt];
+
+					if (lcCompareVertices(Position, Vertex.Position) && Match(Vertex))
+					{
+						Found = static_cast<int>(*IndexIt);
+						break;
+					}
+				}
+			}
+		}
+	}
+
+	return Found;
+}
+
 lcMeshLoaderSection* lcMeshLoaderTypeData::AddSection(lcMeshPrimitiveType PrimitiveType, lcMeshLoaderMaterial* Material)
 {
 	for (const std::unique_ptr<lcMeshLoaderSection>& Section : mSections)
@@ -168,13 +231,13 @@ quint32 lcMeshLoaderTypeData::AddVertex(const lcVector3& Position, bool Optimize
 {
 	if (Optimize)
 	{
-		for (int VertexIdx = static_cast<int>(mVertices.size()) - 1; VertexIdx >= 0; VertexIdx--)
+		const int VertexIdx = FindVertex(Position, [](const lcMeshLoaderVertex&)
 		{
-			const lcMeshLoaderVertex& Vertex = mVertices[VertexIdx];
+			return true;
+		});
 
-			if (lcCompareVertices(Position, Vertex.Position))
-				return VertexIdx;
-		}
+		if (VertexIdx >= 0)
+			return VertexIdx;
 	}
 
 	lcMeshLoaderVertex& Vertex = mVertices.emplace_back();
@@ -190,25 +253,27 @@ quint32 lcMeshLoaderTypeData::AddVertex(const lcVector3& Position, const lcVecto
 {
 	if (Optimize)
 	{
-		for (int VertexIdx = static_cast<int>(mVertices.size()) - 1; VertexIdx >= 0; VertexIdx--)
+		const int VertexIdx = FindVertex(Position, [&Normal](const lcMeshLoaderVertex& Vertex)
+		{
+			return Vertex.NormalWeight == 0.0f || lcDot(Normal, Vertex.Normal) > 0.71f;
+		});
+
+		if (VertexIdx >= 0)
 		{
 			lcMeshLoaderVertex& Vertex = mVertices[VertexIdx];
 
-			if (lcCompareVertices(Position, Vertex.Position))
+			if (Vertex.NormalWeight == 0.0f)
 			{
-				if (Vertex.NormalWeight == 0.0f)
-				{
-					Vertex.Normal = Normal;
-					Vertex.NormalWeight = NormalWeight;
-					return VertexIdx;
-				}
-				else if (lcDot(Normal, Vertex.Normal) > 0.71f)
-				{
-					Vertex.Normal = lcNormalize(Vertex.Normal * Vertex.NormalWeight + Normal * NormalWeight);
-					Vertex.NormalWeight += NormalWeight;
-					return VertexIdx;
-				}
+				Vertex.Normal = Normal;
+				Vertex.NormalWeight = NormalWeight;
+			}
+			else
+			{
+				Vertex.Normal = lcNormalize(Vertex.Normal * Vertex.NormalWeight + Normal * NormalWeight);
+				Vertex.NormalWeight += NormalWeight;
 			}
+
+			return VertexIdx;
 		}
 	}
 
@@ -1115,6 +1180,59 @@ bool lcMeshLoader::LoadMesh(lcFile& File, lcMeshDataType MeshDataType)
 	return ReadMeshData(File, lcMatrix44Identity(), 16, false, MeshDataType);
 }
 
+// Token readers for the numeric fields of line types 1 to 5, they accept the same
+// input as the sscanf conversions they replace and leave Ptr after the token.
+static inline bool lcReadLineInt(const char*& Ptr, int& Value)
+{
+	char* End;
+	const long Number = strtol(Ptr, &End, 10);
+
+	if (End == Ptr)
+		return false;
+
+	Value = static_cast<int>(Number);
+	Ptr = End;
+
+	return true;
+}
+
+static inline int lcReadLineFloats(const char*& Ptr, float* Values, int Count)
+{
+	int ValueIdx;
+
+	for (ValueIdx = 0; ValueIdx < Count; ValueIdx++)
+	{
+		char* End;
+		Values[ValueIdx] = strtof(Ptr, &End);
+
+		if (End == Ptr)
+			break;
+
+		Ptr = End;
+	}
+
+	for (int ZeroIdx = ValueIdx; ZeroIdx < Count; ZeroIdx++)
+		Values[ZeroIdx] = 0.0f;
+
+	return ValueIdx;
+}
+
+static inline void lcReadLineToken(const char* Ptr, char* Token, size_t TokenSize)
+{
+	while (*Ptr && *Ptr <= 32)
+		Ptr++;
+
+	size_t Length = 0;
+
+	while (Ptr[Length] && Ptr[Length] > 32 && Length < TokenSize - 1)
+	{
+		Token[Length] = Ptr[Length];
+		Length++;
+	}
+
+	Token[Length] = 0;
+}
+
 bool lcMeshLoader::ReadMeshData(lcFile& File, const lcMatrix44& CurrentTransform, quint32 CurrentColorCode, bool InvertWinding, lcMeshDataType MeshDataType)
 {
 	char Buffer[1024];
@@ -1134,16 +1252,26 @@ bool lcMeshLoader::ReadMeshData(lcFile& File, const lcMatrix44& CurrentTransform
 
 		Line = Buffer;
 
-		if (sscanf(Line, "%d", &LineType) != 1)
+		const char* Ptr = Line;
+
+		if (!lcReadLineInt(Ptr, LineType))
 			continue;
 
 		if (LineType == 0)
 		{
 			char* Token = Line;
 
+			while (*Token && *Token <= 32)
+				Token++;
+
+			Token++;
+
+			while (*Token && *Token <= 32)
+				Token++;
+
 /*** LPub3D Mod - lpub fade highlight ***/
 			// process archive parts LPub3D colour codes
-			if (strstr(Token, "!COLOUR") != nullptr)
+			if (!strncmp(Token, "!COLOUR", 7) && Token[7] <= 32)
 			{
 				if (!lcLoadColorEntry(Line, Library->GetStudStyle()))
 					qCritical() << qPrintable(QString("Could not load colour meta %1.").arg(Line));
@@ -1152,14 +1280,6 @@ bool lcMeshLoader::ReadMeshData(lcFile& File, const lcMatrix44& CurrentTransform
 			}
 /*** LPub3D Mod end ***/
 
-			while (*Token && *Token <= 32)
-				Token++;
-
-			Token++;
-
-			while (*Token && *Token <= 32)
-				Token++;
-
 			char* End = Token;
 			while (*End && *End > 32)
 				End++;
@@ -1330,19 +1450,28 @@ bool lcMeshLoader::ReadMeshData(lcFile& File, const lcMatrix44& CurrentTransform
 				continue;
 		}
 
-		if (sscanf(Line, "%d %d", &LineType, &ColorCode) != 2)
+		Ptr = Line;
+
+		if (!lcReadLineInt(Ptr, LineType))
+			continue;
+
+		const char* CodeToken = Ptr;
+		int Code;
+
+		if (!lcReadLineInt(Ptr, Code))
 			continue;
 
 		if (LineType < 1 || LineType > 5)
 			continue;
 
-		if (ColorCode == 0)
-		{
-			sscanf(Line, "%d %i", &LineType, &ColorCodeHex);
+		// the colour field is consumed as %i, so direct colours like 0x2RRGGBB are read in full
+		char* CodeEnd;
+		ColorCode = static_cast<quint32>(Code);
+		ColorCodeHex = static_cast<quint32>(strtoul(CodeToken, &CodeEnd, 0));
+		Ptr = CodeEnd;
 
-			if (ColorCode != ColorCodeHex)
-				ColorCode = ColorCodeHex | LC_COLOR_DIRECT;
-		}
+		if (ColorCode == 0 && ColorCode != ColorCodeHex)
+			ColorCode = ColorCodeHex | LC_COLOR_DIRECT;
 
 		if (ColorCode == 16)
 			ColorCode = CurrentColorCode;
@@ -1368,20 +1497,27 @@ bool lcMeshLoader::ReadMeshData(lcFile& File, const lcMatrix44& CurrentTransform
 //			}
 		}
 
-		int Dummy;
+		float Values[12];
 		lcVector3 Points[4];
 
+		if (LineType > 1)
+		{
+			const int NumPoints = LineType == 2 ? 2 : LineType == 3 ? 3 : 4;
+			lcReadLineFloats(Ptr, Values, NumPoints * 3);
+
+			for (int PointIdx = 0; PointIdx < NumPoints; PointIdx++)
+				Points[PointIdx] = lcVector3(Values[PointIdx * 3], Values[PointIdx * 3 + 1], Values[PointIdx * 3 + 2]);
+		}
+
 		switch (LineType)
 		{
 		case 1:
 		{
-			char OriginalFileName[LC_MAXPATH];
-			float fm[12];
-
-			sscanf(Line, "%d %i %f %f %f %f %f %f %f %f %f %f %f %f %s", &LineType, &Dummy, &fm[0], &fm[1], &fm[2], &fm[3], &fm[4], &fm[5], &fm[6], &fm[7], &fm[8], &fm[9], &fm[10], &fm[11], OriginalFileName);
-
+			float (&fm)[12] = Values;
 			char FileName[LC_MAXPATH];
-			strcpy(FileName, OriginalFileName);
+
+			lcReadLineFloats(Ptr, fm, 12);
+			lcReadLineToken(Ptr, FileName, sizeof(FileName));
 
 			char* Ch;
 			for (Ch = FileName; *Ch; Ch++)
@@ -1426,8 +1562,6 @@ bool lcMeshLoader::ReadMeshData(lcFile& File, const lcMatrix44& CurrentTransform
 		} break;
 
 		case 2:
-			sscanf(Line, "%d %i %f %f %f %f %f %f", &LineType, &Dummy, &Points[0].x, &Points[0].y, &Points[0].z, &Points[1].x, &Points[1].y, &Points[1].z);
-
 			Points[0] = lcMul31(Points[0], CurrentTransform);
 			Points[1] = lcMul31(Points[1], CurrentTransform);
 
@@ -1435,9 +1569,6 @@ bool lcMeshLoader::ReadMeshData(lcFile& File, const lcMatrix44& CurrentTransform
 			break;
 
 		case 3:
-			sscanf(Line, "%d %i %f %f %f %f %f %f %f %f %f", &LineType, &Dummy, &Points[0].x, &Points[0].y, &Points[0].z,
-				   &Points[1].x, &Points[1].y, &Points[1].z, &Points[2].x, &Points[2].y, &Points[2].z);
-
 			Points[0] = lcMul31(Points[0], CurrentTransform);
 			Points[1] = lcMul31(Points[1], CurrentTransform);
 			Points[2] = lcMul31(Points[2], CurrentTransform);
@@ -1455,9 +1586,6 @@ bool lcMeshLoader::ReadMeshData(lcFile& File, const lcMatrix44& CurrentTransform
 			break;
 
 		case 4:
-			sscanf(Line, "%d %i %f %f %f %f %f %f %f %f %f %f %f %f", &LineType, &Dummy, &Points[0].x, &Points[0].y, &Points[0].z,
-				   &Points[1].x, &Points[1].y, &Points[1].z, &Points[2].x, &Points[2].y, &Points[2].z, &Points[3].x, &Points[3].y, &Points[3].z);
-
 			Points[0] = lcMul31(Points[0], CurrentTransform);
 			Points[1] = lcMul31(Points[1], CurrentTransform);
 			Points[2] = lcMul31(Points[2], CurrentTransform);
@@ -1476,9 +1604,6 @@ bool lcMeshLoader::ReadMeshData(lcFile& File, const lcMatrix44& CurrentTransform
 			break;
 
 		case 5:
-			sscanf(Line, "%d %i %f %f %f %f %f %f %f %f %f %f %f %f", &LineType, &Dummy, &Points[0].x, &Points[0].y, &Points[0].z,
-				   &Points[1].x, &Points[1].y, &Points[1].z, &Points[2].x, &Points[2].y, &Points[2].z, &Points[3].x, &Points[3].y, &Points[3].z);
-
 			Points[0] = lcMul31(Points[0], CurrentTransform);
 			Points[1] = lcMul31(Points[1], CurrentTransform);
 			Points[2] = lcMul31(Points[2], CurrentTransform);
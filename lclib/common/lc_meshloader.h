@@ -111,6 +111,14 @@ public:
 		mSections.clear();
 		mVertices.clear();
 		mConditionalVertices.clear();
+		ReleaseVertexGrid();
+	}
+
+	// The grid is rebuilt on demand by FindVertex, release its memory once loading is done
+	void ReleaseVertexGrid()
+	{
+		std::unordered_map<quint64, std::vector<quint32>>().swap(mVertexGrid);
+		mGridVertexCount = 0;
 	}
 
 	void SetMeshData(lcLibraryMeshData* MeshData)
@@ -134,7 +142,12 @@ public:
 	std::vector<lcMeshLoaderConditionalVertex> mConditionalVertices;
 
 protected:
+	template<typename MatchType>
+	int FindVertex(const lcVector3& Position, MatchType Match);
+
 	lcLibraryMeshData* mMeshData = nullptr;
+	std::unordered_map<quint64, std::vector<quint32>> mVertexGrid;
+	size_t mGridVertexCount = 0;
 };
 
 class lcLibraryMeshData
@@ -170,6 +183,12 @@ public:
 		mHasStyleStud = false;
 	}
 
+	void ReleaseVertexGrids()
+	{
+		for (lcMeshLoaderTypeData& Data : mData)
+			Data.ReleaseVertexGrid();
+	}
+
 	void SetMeshLoader(lcMeshLoader* MeshLoader)
 	{
 		mMeshLoader = MeshLoader;
@@ -273,7 +273,23 @@ void lcModel::DeleteHistory()
 	for (lcModelHistoryEntry* Entry : mRedoHistory)
 		delete Entry;
 	mRedoHistory.clear();
+/*** LPub3D Mod - history deltas ***/
+	mHistoryLines.clear();
+	mHistoryPieceLines.clear();
+	mHistorySize = 0;
+/*** LPub3D Mod end ***/
+}
+
+/*** LPub3D Mod - history deltas ***/
+void lcModel::DeleteHistoryEntry(lcModelHistoryEntry* Entry)
+{
+	if (mSavedHistory == Entry)
+		mSavedHistory = nullptr;
+
+	mHistorySize -= Entry->Size;
+	delete Entry;
 }
+/*** LPub3D Mod end ***/
 
 void lcModel::DeleteModel()
 {
@@ -361,7 +377,9 @@ void lcModel::UpdatePieceInfo(std::vector<lcModel*>& UpdatedModels)
 	mPieceInfo->SetBoundingBox(Min, Max);
 }
 
-void lcModel::SaveLDraw(QTextStream& Stream, bool SelectedOnly, lcStep LastStep) const
+/*** LPub3D Mod - history deltas ***/
+void lcModel::SaveLDraw(QTextStream& Stream, bool SelectedOnly, lcStep LastStep, std::vector<qint64>* PieceOffsets) const
+/*** LPub3D Mod end ***/
 {
 	const QLatin1String LineEnding("\r\n");
 /*** LPub3D Mod - LPUB meta command ***/
@@ -497,8 +515,24 @@ void lcModel::SaveLDraw(QTextStream& Stream, bool SelectedOnly, lcStep LastStep)
 			}
 		}
 
+/*** LPub3D Mod - history deltas ***/
+		if (PieceOffsets)
+		{
+			Stream.flush();
+			PieceOffsets->push_back(Stream.pos());
+		}
+/*** LPub3D Mod end ***/
+
 		Piece->SaveLDraw(Stream);
 
+/*** LPub3D Mod - history deltas ***/
+		if (PieceOffsets)
+		{
+			Stream.flush();
+			PieceOffsets->push_back(Stream.pos());
+		}
+/*** LPub3D Mod end ***/
+
 		if (Piece->mPieceInfo->GetSynthInfo())
 /*** LPub3D Mod - LPUB meta command ***/
 			Stream << QLatin1String(Meta + " SYNTH END\r\n");
@@ -1303,6 +1337,9 @@ void lcModel::Merge(lcModel* Other)
 	}
 
 	Other->mPieces.clear();
+/*** LPub3D Mod - picking tree ***/
+	lcPickBoxesChanged();
+/*** LPub3D Mod end ***/
 
 	for (std::unique_ptr<lcCamera>& Camera : Other->mCameras)
 	{
@@ -1837,11 +1874,95 @@ void lcModel::SaveStepImages(const QString& BaseName, bool AddStepSuffix, bool Z
 	}
 }
 
+/*** LPub3D Mod - picking tree ***/
+#define LC_MODEL_PICK_TREE_LEAF 4
+
+// Brings the bounding volume hierarchy over the piece world boxes up to date.
+// Nothing is scanned while no piece was added, removed, moved or reshaped
+// since the last update. Otherwise pieces that moved or changed shape refit
+// the tree, it is rebuilt when pieces were added or removed or when many of
+// them moved at once.
+void lcModel::UpdatePickTree() const
+{
+	const quint64 Generation = lcGetPickGeneration();
+
+	if (Generation == mPickTreeGeneration)
+		return;
+
+	mPickTreeGeneration = Generation;
+
+	const size_t NumPieces = mPieces.size();
+	bool Rebuild = mPickTreeEntries.size() != NumPieces || mPickTree.IsEmpty();
+	size_t NumChanged = 0;
+
+	mPickTreeEntries.resize(NumPieces);
+	mPickTreeBoxes.resize(NumPieces);
+
+	for (size_t PieceIdx = 0; PieceIdx < NumPieces; PieceIdx++)
+	{
+		const lcPiece* Piece = mPieces[PieceIdx].get();
+		lcPickTreeEntry& Entry = mPickTreeEntries[PieceIdx];
+		const lcBoundingBox LocalBox = Piece->GetPickBoundingBox();
+
+		if (Entry.Piece == Piece && !memcmp(&Entry.ModelWorld, &Piece->mModelWorld, sizeof(lcMatrix44)) && Entry.LocalBox.Min == LocalBox.Min && Entry.LocalBox.Max == LocalBox.Max)
+			continue;
+
+		if (Entry.Piece != Piece)
+			Rebuild = true;
+
+		Entry.Piece = Piece;
+		Entry.ModelWorld = Piece->mModelWorld;
+		Entry.LocalBox = LocalBox;
+
+		lcVector3 Points[8];
+		lcGetBoxCorners(LocalBox, Points);
+
+		lcBoundingBox& WorldBox = mPickTreeBoxes[PieceIdx];
+		WorldBox.Min = lcVector3(FLT_MAX, FLT_MAX, FLT_MAX);
+		WorldBox.Max = lcVector3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+		for (const lcVector3& Point : Points)
+		{
+			const lcVector3 WorldPoint = lcMul31(Point, Entry.ModelWorld);
+
+			WorldBox.Min = lcMin(WorldBox.Min, WorldPoint);
+			WorldBox.Max = lcMax(WorldBox.Max, WorldPoint);
+		}
+
+		NumChanged++;
+	}
+
+	if (Rebuild || NumChanged * 4 > NumPieces)
+		mPickTree.Build(mPickTreeBoxes, LC_MODEL_PICK_TREE_LEAF);
+	else if (NumChanged)
+		mPickTree.Refit(mPickTreeBoxes);
+}
+/*** LPub3D Mod end ***/
+
 void lcModel::RayTest(lcObjectRayTest& ObjectRayTest) const
 {
-	for (const std::unique_ptr<lcPiece>& Piece : mPieces)
+/*** LPub3D Mod - picking tree ***/
+	UpdatePickTree();
+
+	// Pieces are tested in model order so ties resolve as before.
+	std::vector<int> PieceIndices;
+
+	mPickTree.RayTest(ObjectRayTest.Start, ObjectRayTest.End, nullptr, [&PieceIndices](int PieceIdx)
+	{
+		PieceIndices.push_back(PieceIdx);
+		return false;
+	});
+
+	std::sort(PieceIndices.begin(), PieceIndices.end());
+
+	for (int PieceIdx : PieceIndices)
+	{
+		const lcPiece* Piece = mPieces[PieceIdx].get();
+
 		if (Piece->IsVisible(mCurrentStep) && (!ObjectRayTest.IgnoreSelected || !Piece->IsSelected()))
 			Piece->RayTest(ObjectRayTest);
+	}
+/*** LPub3D Mod end ***/
 
 	if (ObjectRayTest.PiecesOnly)
 		return;
@@ -1857,9 +1978,27 @@ void lcModel::RayTest(lcObjectRayTest& ObjectRayTest) const
 
 void lcModel::BoxTest(lcObjectBoxTest& ObjectBoxTest) const
 {
-	for (const std::unique_ptr<lcPiece>& Piece : mPieces)
+/*** LPub3D Mod - picking tree ***/
+	UpdatePickTree();
+
+	std::vector<int> PieceIndices;
+
+	mPickTree.PlanesTest(ObjectBoxTest.Planes, [&PieceIndices](int PieceIdx)
+	{
+		PieceIndices.push_back(PieceIdx);
+		return false;
+	});
+
+	std::sort(PieceIndices.begin(), PieceIndices.end());
+
+	for (int PieceIdx : PieceIndices)
+	{
+		const lcPiece* Piece = mPieces[PieceIdx].get();
+
 		if (Piece->IsVisible(mCurrentStep))
 			Piece->BoxTest(ObjectBoxTest);
+	}
+/*** LPub3D Mod end ***/
 
 	for (const std::unique_ptr<lcCamera>& Camera : mCameras)
 		if (Camera.get() != ObjectBoxTest.ViewCamera && Camera->IsVisible())
@@ -1874,8 +2013,23 @@ bool lcModel::SubModelMinIntersectDist(const lcVector3& WorldStart, const lcVect
 {
 	bool MinIntersect = false;
 
-	for (const std::unique_ptr<lcPiece>& Piece : mPieces)
+/*** LPub3D Mod - picking tree ***/
+	UpdatePickTree();
+
+	std::vector<int> PieceIndices;
+
+	mPickTree.RayTest(WorldStart, WorldEnd, nullptr, [&PieceIndices](int PieceIdx)
+	{
+		PieceIndices.push_back(PieceIdx);
+		return false;
+	});
+
+	std::sort(PieceIndices.begin(), PieceIndices.end());
+
+	for (int PieceIdx : PieceIndices)
 	{
+		const lcPiece* Piece = mPieces[PieceIdx].get();
+/*** LPub3D Mod end ***/
 		const lcMatrix44 InverseWorldMatrix = lcMatrix44AffineInverse(Piece->mModelWorld);
 		const lcVector3 Start = lcMul31(WorldStart, InverseWorldMatrix);
 		const lcVector3 End = lcMul31(WorldEnd, InverseWorldMatrix);
@@ -1895,11 +2049,22 @@ bool lcModel::SubModelMinIntersectDist(const lcVector3& WorldStart, const lcVect
 
 bool lcModel::SubModelBoxTest(const lcVector4 Planes[6]) const
 {
-	for (const std::unique_ptr<lcPiece>& Piece : mPieces)
-		if (Piece->IsVisibleInSubModel() && Piece->mPieceInfo->BoxTest(Piece->mModelWorld, Planes))
-			return true;
+/*** LPub3D Mod - picking tree ***/
+	UpdatePickTree();
 
-	return false;
+	bool Intersects = false;
+
+	mPickTree.PlanesTest(Planes, [this, Planes, &Intersects](int PieceIdx)
+	{
+		const lcPiece* Piece = mPieces[PieceIdx].get();
+
+		Intersects = Piece->IsVisibleInSubModel() && Piece->mPieceInfo->BoxTest(Piece->mModelWorld, Planes);
+
+		return Intersects;
+	});
+
+	return Intersects;
+/*** LPub3D Mod end ***/
 }
 
 void lcModel::SubModelCompareBoundingBox(const lcMatrix44& WorldMatrix, lcVector3& Min, lcVector3& Max) const
@@ -1916,20 +2081,309 @@ void lcModel::SubModelAddBoundingBoxPoints(const lcMatrix44& WorldMatrix, std::v
 			Piece->SubModelAddBoundingBoxPoints(WorldMatrix, Points);
 }
 
+/*** LPub3D Mod - history deltas ***/
+// Checkpoints store the LDraw lines that differ from the previous checkpoint.
+// Each piece, camera, light and group is saved on lines of its own so a delta
+// only holds the objects that changed. Every LC_MODEL_HISTORY_SNAPSHOT_INTERVAL
+// checkpoints keep the whole text, which resynchronises undo and redo.
+// Undo and redo update the pieces in place when only piece lines changed
+// and no piece gained or lost lines, otherwise the model is reloaded.
+#define LC_MODEL_HISTORY_SNAPSHOT_INTERVAL 32
+#define LC_MODEL_HISTORY_MAX_SIZE (64 * 1024 * 1024)
+
+static qint64 lcHistoryLinesSize(const QList<QByteArray>& Lines)
+{
+	qint64 Size = 0;
+
+	for (const QByteArray& Line : Lines)
+		Size += Line.size() + 1;
+
+	return Size;
+}
+
+static void lcHistoryAddDelta(std::vector<lcModelHistoryDelta>& Deltas, const QList<QByteArray>& OldLines, const QList<QByteArray>& NewLines, int Line, int OldCount, int NewCount)
+{
+	lcModelHistoryDelta Delta;
+
+	Delta.Line = Line;
+	Delta.OldLines = OldLines.mid(Line, OldCount);
+	Delta.NewLines = NewLines.mid(Line, NewCount);
+
+	Deltas.emplace_back(std::move(Delta));
+}
+
+static std::vector<lcModelHistoryDelta> lcHistoryDiff(const QList<QByteArray>& OldLines, const QList<QByteArray>& NewLines)
+{
+	std::vector<lcModelHistoryDelta> Deltas;
+
+	if (OldLines.size() == NewLines.size())
+	{
+		// Objects were modified in place, record each run of changed lines.
+		for (int Line = 0; Line < NewLines.size(); )
+		{
+			if (OldLines[Line] == NewLines[Line])
+			{
+				Line++;
+				continue;
+			}
+
+			int End = Line + 1;
+
+			while (End < NewLines.size() && OldLines[End] != NewLines[End])
+				End++;
+
+			lcHistoryAddDelta(Deltas, OldLines, NewLines, Line, End - Line, End - Line);
+			Line = End;
+		}
+	}
+	else
+	{
+		// Objects were added or removed, record the lines between the common prefix and suffix.
+		const int MinCount = std::min(OldLines.size(), NewLines.size());
+		int Prefix = 0;
+
+		while (Prefix < MinCount && OldLines[Prefix] == NewLines[Prefix])
+			Prefix++;
+
+		int Suffix = 0;
+
+		while (Suffix < MinCount - Prefix && OldLines[OldLines.size() - 1 - Suffix] == NewLines[NewLines.size() - 1 - Suffix])
+			Suffix++;
+
+		lcHistoryAddDelta(Deltas, OldLines, NewLines, Prefix, OldLines.size() - Prefix - Suffix, NewLines.size() - Prefix - Suffix);
+	}
+
+	return Deltas;
+}
+
+static void lcHistoryApplyDeltas(QList<QByteArray>& Lines, const std::vector<lcModelHistoryDelta>& Deltas, bool Forward)
+{
+	// Deltas are sorted by line, applying them last to first keeps the earlier line numbers valid.
+	for (auto DeltaIt = Deltas.rbegin(); DeltaIt != Deltas.rend(); ++DeltaIt)
+	{
+		const QList<QByteArray>& From = Forward ? DeltaIt->OldLines : DeltaIt->NewLines;
+		const QList<QByteArray>& To = Forward ? DeltaIt->NewLines : DeltaIt->OldLines;
+
+		if (From.size() == To.size())
+		{
+			for (int LineIdx = 0; LineIdx < To.size(); LineIdx++)
+				Lines[DeltaIt->Line + LineIdx] = To[LineIdx];
+		}
+		else
+			Lines = Lines.mid(0, DeltaIt->Line) + To + Lines.mid(DeltaIt->Line + From.size());
+	}
+}
+
+// Lines of the same kind share their key, type 1 lines also keep their part id.
+static QByteArray lcHistoryLineKey(const QByteArray& Line)
+{
+	const bool PieceLine = Line.startsWith("1 ");
+	const int TokenCount = PieceLine ? 14 : 4;
+	int End = -1;
+
+	for (int TokenIdx = 0; TokenIdx < TokenCount; TokenIdx++)
+	{
+		End = Line.indexOf(' ', End + 1);
+
+		if (End == -1)
+			return Line.trimmed();
+	}
+
+	return PieceLine ? "1 " + Line.mid(End + 1).trimmed() : Line.left(End);
+}
+
+QList<QByteArray> lcModel::SaveHistoryLines(std::vector<std::pair<int, int>>& PieceLines) const
+{
+	QByteArray File;
+	std::vector<qint64> PieceOffsets;
+
+	{
+		QTextStream Stream(&File);
+		SaveLDraw(Stream, false, 0, &PieceOffsets);
+	}
+
+	PieceLines.clear();
+	PieceLines.reserve(PieceOffsets.size() / 2);
+
+	const char* Data = File.constData();
+	qint64 Pos = 0;
+	int Line = 0;
+
+	for (size_t OffsetIdx = 0; OffsetIdx + 1 < PieceOffsets.size(); OffsetIdx += 2)
+	{
+		for (; Pos < PieceOffsets[OffsetIdx]; Pos++)
+			if (Data[Pos] == '\n')
+				Line++;
+
+		const int FirstLine = Line;
+
+		for (; Pos < PieceOffsets[OffsetIdx + 1]; Pos++)
+			if (Data[Pos] == '\n')
+				Line++;
+
+		PieceLines.emplace_back(FirstLine, Line);
+	}
+
+	return File.split('\n');
+}
+
+bool lcModel::LoadCheckPointPieces(const std::vector<lcModelHistoryDelta>& Deltas, bool Forward)
+{
+	if (mIsPreview || mHistoryPieceLines.size() != mPieces.size())
+		return false;
+
+	// Every changed line must belong to a piece and keep its kind so the piece line ranges stay valid.
+	std::vector<size_t> PieceIndices;
+
+	for (const lcModelHistoryDelta& Delta : Deltas)
+	{
+		const QList<QByteArray>& From = Forward ? Delta.OldLines : Delta.NewLines;
+		const QList<QByteArray>& To = Forward ? Delta.NewLines : Delta.OldLines;
+
+		if (From.size() != To.size())
+			return false;
+
+		for (int LineIdx = 0; LineIdx < To.size(); LineIdx++)
+		{
+			if (lcHistoryLineKey(From[LineIdx]) != lcHistoryLineKey(To[LineIdx]))
+				return false;
+
+			const int Line = Delta.Line + LineIdx;
+			auto PieceIt = std::upper_bound(mHistoryPieceLines.begin(), mHistoryPieceLines.end(), Line, [](int LineNumber, const std::pair<int, int>& Range)
+			{
+				return LineNumber < Range.first;
+			});
+
+			if (PieceIt == mHistoryPieceLines.begin() || Line >= (--PieceIt)->second)
+				return false;
+
+			const size_t PieceIndex = PieceIt - mHistoryPieceLines.begin();
+
+			if (PieceIndices.empty() || PieceIndices.back() != PieceIndex)
+				PieceIndices.push_back(PieceIndex);
+		}
+	}
+
+	lcHistoryApplyDeltas(mHistoryLines, Deltas, Forward);
+
+	for (size_t PieceIndex : PieceIndices)
+	{
+		lcPiece* Piece = mPieces[PieceIndex].get();
+		const std::pair<int, int>& PieceLines = mHistoryPieceLines[PieceIndex];
+
+		Piece->RemoveKeyFrames();
+
+		for (int LineIdx = PieceLines.first; LineIdx < PieceLines.second; LineIdx++)
+		{
+			QString Line = QString::fromUtf8(mHistoryLines[LineIdx]).trimmed();
+			QTextStream LineStream(&Line, QIODevice::ReadOnly);
+
+			QString Token;
+			LineStream >> Token;
+
+			if (Token == QLatin1String("0"))
+			{
+				LineStream >> Token >> Token;
+				Piece->ParseLDrawLine(LineStream);
+			}
+			else if (Token == QLatin1String("1"))
+			{
+				int ColorCode;
+				LineStream >> ColorCode;
+
+				float IncludeMatrix[12];
+				for (int TokenIdx = 0; TokenIdx < 12; TokenIdx++)
+					LineStream >> IncludeMatrix[TokenIdx];
+
+				const lcMatrix44 IncludeTransform(lcVector4(IncludeMatrix[3], IncludeMatrix[6], IncludeMatrix[9], 0.0f), lcVector4(IncludeMatrix[4], IncludeMatrix[7], IncludeMatrix[10], 0.0f),
+				                                  lcVector4(IncludeMatrix[5], IncludeMatrix[8], IncludeMatrix[11], 0.0f), lcVector4(IncludeMatrix[0], IncludeMatrix[1], IncludeMatrix[2], 1.0f));
+
+				const float* Matrix = IncludeTransform.GetFloats();
+				const lcMatrix44 Transform(lcVector4(Matrix[0], Matrix[2], -Matrix[1], 0.0f), lcVector4(Matrix[8], Matrix[10], -Matrix[9], 0.0f),
+				                           lcVector4(-Matrix[4], -Matrix[6], Matrix[5], 0.0f), lcVector4(Matrix[12], Matrix[14], -Matrix[13], 1.0f));
+
+				Piece->Initialize(Transform, Piece->GetStepShow());
+				Piece->SetColorCode(ColorCode);
+			}
+		}
+	}
+
+	CalculateStep(mCurrentStep);
+
+	gMainWindow->UpdateTimeline(true, false);
+	gMainWindow->UpdateCurrentStep();
+	gMainWindow->UpdateSelectedObjects(true);
+	UpdateAllViews();
+
+	return true;
+}
+
+void lcModel::TrimHistory()
+{
+	// Undo never goes past the oldest entry so its deltas are not needed once it becomes the oldest.
+	while (mHistorySize > LC_MODEL_HISTORY_MAX_SIZE && mUndoHistory.size() > 2)
+	{
+		DeleteHistoryEntry(mUndoHistory.back());
+		mUndoHistory.pop_back();
+
+		lcModelHistoryEntry* Oldest = mUndoHistory.back();
+		qint64 DeltaBytes = 0;
+
+		for (const lcModelHistoryDelta& Delta : Oldest->Deltas)
+			DeltaBytes += lcHistoryLinesSize(Delta.OldLines) + lcHistoryLinesSize(Delta.NewLines);
+
+		mHistorySize -= DeltaBytes;
+		Oldest->Size -= DeltaBytes;
+		Oldest->Deltas.clear();
+	}
+}
+/*** LPub3D Mod end ***/
+
 void lcModel::SaveCheckpoint(const QString& Description)
 {
 	lcModelHistoryEntry* ModelHistoryEntry = new lcModelHistoryEntry();
 
 	ModelHistoryEntry->Description = Description;
 
-	QTextStream Stream(&ModelHistoryEntry->File);
-	SaveLDraw(Stream, false, 0);
+/*** LPub3D Mod - history deltas ***/
+	QList<QByteArray> Lines = SaveHistoryLines(mHistoryPieceLines);
+
+	int DeltaCount = 0;
+
+	for (const lcModelHistoryEntry* Entry : mUndoHistory)
+	{
+		if (Entry->Snapshot)
+			break;
+
+		DeltaCount++;
+	}
+
+	if (mUndoHistory.empty() || DeltaCount >= LC_MODEL_HISTORY_SNAPSHOT_INTERVAL - 1)
+	{
+		ModelHistoryEntry->Snapshot = true;
+		ModelHistoryEntry->File = Lines.join('\n');
+		ModelHistoryEntry->Size = ModelHistoryEntry->File.size();
+	}
+
+	if (!mUndoHistory.empty())
+	{
+		ModelHistoryEntry->Deltas = lcHistoryDiff(mHistoryLines, Lines);
+
+		for (const lcModelHistoryDelta& Delta : ModelHistoryEntry->Deltas)
+			ModelHistoryEntry->Size += lcHistoryLinesSize(Delta.OldLines) + lcHistoryLinesSize(Delta.NewLines);
+	}
+
+	mHistoryLines = std::move(Lines);
+	mHistorySize += ModelHistoryEntry->Size;
 
 	mUndoHistory.insert(mUndoHistory.begin(), ModelHistoryEntry);
 	for (lcModelHistoryEntry* Entry : mRedoHistory)
-		delete Entry;
+		DeleteHistoryEntry(Entry);
 	mRedoHistory.clear();
 
+	TrimHistory();
+/*** LPub3D Mod end ***/
+
 	if (!Description.isEmpty())
 	{
 		gMainWindow->UpdateModified(IsModified());
@@ -1950,7 +2404,9 @@ void lcModel::SaveCheckpoint(const QString& Description)
 	}
 }
 
-void lcModel::LoadCheckPoint(lcModelHistoryEntry* CheckPoint)
+/*** LPub3D Mod - history deltas ***/
+void lcModel::LoadCheckPoint()
+/*** LPub3D Mod end ***/
 {
 	lcPiecesLibrary* Library = lcGetPiecesLibrary();
 	std::vector<PieceInfo*> LoadedInfos;
@@ -1979,7 +2435,10 @@ void lcModel::LoadCheckPoint(lcModelHistoryEntry* CheckPoint)
 
 	DeleteModel();
 
-	QBuffer Buffer(&CheckPoint->File);
+/*** LPub3D Mod - history deltas ***/
+	QByteArray File = mHistoryLines.join('\n');
+	QBuffer Buffer(&File);
+/*** LPub3D Mod end ***/
 	Buffer.open(QIODevice::ReadOnly);
 	LoadLDraw(Buffer, lcGetActiveProject());
 
@@ -1999,6 +2458,16 @@ void lcModel::LoadCheckPoint(lcModelHistoryEntry* CheckPoint)
 
 	for (PieceInfo* Info : LoadedInfos)
 		Library->ReleasePieceInfo(Info);
+
+/*** LPub3D Mod - history deltas ***/
+	// The piece line ranges are only known when the reloaded model saves back to the same text
+	std::vector<std::pair<int, int>> PieceLines;
+
+	if (SaveHistoryLines(PieceLines) == mHistoryLines)
+		mHistoryPieceLines = std::move(PieceLines);
+	else
+		mHistoryPieceLines.clear();
+/*** LPub3D Mod end ***/
 }
 
 void lcModel::SetActive(bool Active)
@@ -2604,6 +3073,9 @@ void lcModel::InsertPiece(lcPiece* Piece, size_t Index)
 	}
 
 	mPieces.insert(mPieces.begin() + Index, std::unique_ptr<lcPiece>(Piece));
+/*** LPub3D Mod - picking tree ***/
+	lcPickBoxesChanged();
+/*** LPub3D Mod end ***/
 }
 
 /*** LPub3D Mod - viewer interface ***/
@@ -3028,6 +3500,9 @@ void lcModel::SetPieceSteps(const std::vector<std::pair<lcPiece*, lcStep>>& Piec
 			mPieces[PieceIdx].release();
 			mPieces[PieceIdx] = std::unique_ptr<lcPiece>(Piece);
 			Piece->SetStepShow(Step);
+/*** LPub3D Mod - picking tree ***/
+			lcPickBoxesChanged();
+/*** LPub3D Mod end ***/
 
 			if (!Piece->IsVisible(mCurrentStep))
 				Piece->SetSelected(false);
@@ -3160,6 +3635,9 @@ void lcModel::MoveSelectionToModel(lcModel* Model)
 			Piece->CompareBoundingBox(Min, Max);
 			mPieces[PieceIndex].release();
 			mPieces.erase(mPieces.begin() + PieceIndex);
+/*** LPub3D Mod - picking tree ***/
+			lcPickBoxesChanged();
+/*** LPub3D Mod end ***/
 			Piece->SetGroup(nullptr); // todo: copy groups
 			Pieces.emplace_back(Piece);
 			FirstStep = qMin(FirstStep, Piece->GetStepShow());
@@ -3216,6 +3694,9 @@ void lcModel::InlineSelectedModels()
 
 		mPieces[PieceIndex].release();
 		mPieces.erase(mPieces.begin() + PieceIndex);
+/*** LPub3D Mod - picking tree ***/
+		lcPickBoxesChanged();
+/*** LPub3D Mod end ***/
 
 		lcModel* Model = Piece->mPieceInfo->GetModel();
 
@@ -3925,7 +4406,9 @@ void lcModel::EndPropertyEdit(lcObjectPropertyId PropertyId, bool Accept)
 	if (!Accept)
 	{
 		if (!mUndoHistory.empty())
-			LoadCheckPoint(mUndoHistory.front());
+/*** LPub3D Mod - history deltas ***/
+			LoadCheckPoint();
+/*** LPub3D Mod end ***/
 		return;
 	}
 
@@ -5077,7 +5560,17 @@ void lcModel::UndoAction()
 	mUndoHistory.erase(mUndoHistory.begin());
 	mRedoHistory.insert(mRedoHistory.begin(), Undo);
 
-	LoadCheckPoint(mUndoHistory[0]);
+/*** LPub3D Mod - history deltas ***/
+	if (!LoadCheckPointPieces(Undo->Deltas, false))
+	{
+		if (mUndoHistory[0]->Snapshot)
+			mHistoryLines = mUndoHistory[0]->File.split('\n');
+		else
+			lcHistoryApplyDeltas(mHistoryLines, Undo->Deltas, false);
+
+		LoadCheckPoint();
+	}
+/*** LPub3D Mod end ***/
 
 	gMainWindow->UpdateModified(IsModified());
 	gMainWindow->UpdateUndoRedo(mUndoHistory.size() > 1 ? mUndoHistory[0]->Description : nullptr, !mRedoHistory.empty() ? mRedoHistory[0]->Description : nullptr);
@@ -5095,7 +5588,17 @@ void lcModel::RedoAction()
 	mRedoHistory.erase(mRedoHistory.begin());
 	mUndoHistory.insert(mUndoHistory.begin(), Redo);
 
-	LoadCheckPoint(Redo);
+/*** LPub3D Mod - history deltas ***/
+	if (!LoadCheckPointPieces(Redo->Deltas, true))
+	{
+		if (Redo->Snapshot)
+			mHistoryLines = Redo->File.split('\n');
+		else
+			lcHistoryApplyDeltas(mHistoryLines, Redo->Deltas, true);
+
+		LoadCheckPoint();
+	}
+/*** LPub3D Mod end ***/
 
 	gMainWindow->UpdateModified(IsModified());
 	gMainWindow->UpdateUndoRedo(mUndoHistory.size() > 1 ? mUndoHistory[0]->Description : nullptr, !mRedoHistory.empty() ? mRedoHistory[0]->Description : nullptr);
@@ -5115,7 +5618,9 @@ void lcModel::EndMouseTool(lcTool Tool, bool Accept)
 	if (!Accept)
 	{
 		if (!mUndoHistory.empty())
-			LoadCheckPoint(mUndoHistory.front());
+/*** LPub3D Mod - history deltas ***/
+			LoadCheckPoint();
+/*** LPub3D Mod end ***/
 		return;
 	}
 
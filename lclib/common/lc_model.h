@@ -2,6 +2,9 @@
 
 #include "lc_math.h"
 #include "lc_commands.h"
+/*** LPub3D Mod - picking tree ***/
+#include "lc_bvh.h"
+/*** LPub3D Mod end ***/
 
 enum class lcObjectPropertyId;
 
@@ -120,11 +123,34 @@ protected:
 /*** LPub3D Mod end ***/
 };
 
+/*** LPub3D Mod - history deltas ***/
+struct lcModelHistoryDelta
+{
+	int Line;                    // first changed line, the same in both texts
+	QList<QByteArray> OldLines;  // lines of the previous entry
+	QList<QByteArray> NewLines;  // lines of this entry
+};
+/*** LPub3D Mod end ***/
+
 struct lcModelHistoryEntry
 {
 	QByteArray File;
 	QString Description;
+/*** LPub3D Mod - history deltas ***/
+	bool Snapshot = false; // File holds the whole model, otherwise Deltas lead from the previous entry
+	std::vector<lcModelHistoryDelta> Deltas;
+	qint64 Size = 0;
+/*** LPub3D Mod end ***/
+};
+
+/*** LPub3D Mod - picking tree ***/
+struct lcPickTreeEntry
+{
+	const lcPiece* Piece = nullptr;
+	lcMatrix44 ModelWorld;
+	lcBoundingBox LocalBox;
 };
+/*** LPub3D Mod end ***/
 
 class lcModel
 {
@@ -283,7 +309,9 @@ public:
 	void RemoveFocusPieceFromGroup();
 	void ShowEditGroupsDialog();
 
-	void SaveLDraw(QTextStream& Stream, bool SelectedOnly, lcStep LastStep) const;
+/*** LPub3D Mod - history deltas ***/
+	void SaveLDraw(QTextStream& Stream, bool SelectedOnly, lcStep LastStep, std::vector<qint64>* PieceOffsets = nullptr) const;
+/*** LPub3D Mod end ***/
 	void LoadLDraw(QIODevice& Device, Project* Project);
 	bool LoadBinary(lcFile* File);
 	bool LoadLDD(const QString& FileData);
@@ -464,7 +492,13 @@ protected:
 	void DeleteModel();
 	void DeleteHistory();
 	void SaveCheckpoint(const QString& Description);
-	void LoadCheckPoint(lcModelHistoryEntry* CheckPoint);
+/*** LPub3D Mod - history deltas ***/
+	void LoadCheckPoint();
+	bool LoadCheckPointPieces(const std::vector<lcModelHistoryDelta>& Deltas, bool Forward);
+	QList<QByteArray> SaveHistoryLines(std::vector<std::pair<int, int>>& PieceLines) const;
+	void DeleteHistoryEntry(lcModelHistoryEntry* Entry);
+	void TrimHistory();
+/*** LPub3D Mod end ***/
 
 	QString GetGroupName(const QString& Prefix);
 	void RemoveEmptyGroups();
@@ -477,6 +511,9 @@ protected:
 /*** LPub3D Mod end ***/
 
 	void SelectGroup(lcGroup* TopGroup, bool Select);
+/*** LPub3D Mod - picking tree ***/
+	void UpdatePickTree() const;
+/*** LPub3D Mod end ***/
 
 //	void AddPiece(lcPiece* Piece); /*** LPub3D Mod - viewer interface (moved to public) ***/
 	void InsertPiece(lcPiece* Piece, size_t Index);
@@ -504,6 +541,18 @@ protected:
 	lcModelHistoryEntry* mSavedHistory;
 	std::vector<lcModelHistoryEntry*> mUndoHistory;
 	std::vector<lcModelHistoryEntry*> mRedoHistory;
+/*** LPub3D Mod - history deltas ***/
+	QList<QByteArray> mHistoryLines; // model text of the front undo entry
+	std::vector<std::pair<int, int>> mHistoryPieceLines; // line range of each piece in mHistoryLines, empty when unknown
+	qint64 mHistorySize = 0;
+/*** LPub3D Mod end ***/
+
+/*** LPub3D Mod - picking tree ***/
+	mutable std::vector<lcPickTreeEntry> mPickTreeEntries;
+	mutable std::vector<lcBoundingBox> mPickTreeBoxes;
+	mutable lcBoundingBoxTree mPickTree;
+	mutable quint64 mPickTreeGeneration = 0;
+/*** LPub3D Mod end ***/
 
 	Q_DECLARE_TR_FUNCTIONS(lcModel);
 };
@@ -16,6 +16,9 @@ lcScene::lcScene()
 	mMeshLODDistance = 250.0f;
 	mHasFadedParts = false;
 	mPreTranslucentCallback = nullptr;
+/*** LPub3D Mod - frustum culling ***/
+	mFrustumCulling = true;
+/*** LPub3D Mod end ***/
 }
 
 void lcScene::Begin(const lcMatrix44& ViewMatrix)
@@ -27,6 +30,9 @@ void lcScene::Begin(const lcMatrix44& ViewMatrix)
 	mOpaqueMeshes.clear();
 	mTranslucentMeshes.clear();
 	mInterfaceObjects.clear();
+/*** LPub3D Mod - frustum culling ***/
+	mVisibleMeshes.clear();
+/*** LPub3D Mod end ***/
 
 	const lcPreferences& Preferences = lcGetPreferences();
 	mHighlightColor = lcVector4FromColor(Preferences.mHighlightNewPartsColor);
@@ -45,8 +51,23 @@ void lcScene::End()
 		const int Texture1 = Mesh1->mFlags & lcMeshFlag::HasTexture;
 		const int Texture2 = Mesh2->mFlags & lcMeshFlag::HasTexture;
 
+/*** LPub3D Mod - frustum culling ***/
+		// Keep instances of the same mesh, color and state together so
+		// consecutive draws only change the world matrix.
 		if (Texture1 == Texture2)
-			return Mesh1 < Mesh2;
+		{
+			if (Mesh1 != Mesh2)
+				return Mesh1 < Mesh2;
+
+			const lcRenderMesh& RenderMesh1 = mRenderMeshes[Index1];
+			const lcRenderMesh& RenderMesh2 = mRenderMeshes[Index2];
+
+			if (RenderMesh1.ColorIndex != RenderMesh2.ColorIndex)
+				return RenderMesh1.ColorIndex < RenderMesh2.ColorIndex;
+
+			return RenderMesh1.State < RenderMesh2.State;
+		}
+/*** LPub3D Mod end ***/
 
 		return Texture1 ? false : true;
 	};
@@ -110,6 +131,45 @@ void lcScene::AddMesh(lcMesh* Mesh, const lcMatrix44& WorldMatrix, int ColorInde
 	}
 }
 
+/*** LPub3D Mod - frustum culling ***/
+// Marks the meshes whose bounding box is inside the frustum of the current
+// projection. Tiled renders call Draw once per tile so each tile only draws
+// the meshes it shows.
+void lcScene::UpdateVisibleMeshes(lcContext* Context) const
+{
+	const int NumMeshes = static_cast<int>(mRenderMeshes.size());
+
+	mVisibleMeshes.assign(NumMeshes, 1);
+
+	if (mFrustumCulling)
+	{
+		lcVector4 Planes[6];
+		lcGetFrustumPlanes(mViewMatrix, Context->GetProjectionMatrix(), Planes);
+
+		for (int MeshIdx = 0; MeshIdx < NumMeshes; MeshIdx++)
+		{
+			const lcRenderMesh& RenderMesh = mRenderMeshes[MeshIdx];
+			const lcBoundingBox& BoundingBox = RenderMesh.Mesh->mBoundingBox;
+			const lcMatrix44& WorldMatrix = RenderMesh.WorldMatrix;
+			const lcVector3 Center = lcMul31((BoundingBox.Min + BoundingBox.Max) * 0.5f, WorldMatrix);
+			const lcVector3 Extent = (BoundingBox.Max - BoundingBox.Min) * 0.5f;
+
+			for (const lcVector4& Plane : Planes)
+			{
+				// Distance from the box center to the plane at which the box starts to cross it
+				const float Radius = fabsf(lcDot3(WorldMatrix[0], Plane)) * Extent[0] + fabsf(lcDot3(WorldMatrix[1], Plane)) * Extent[1] + fabsf(lcDot3(WorldMatrix[2], Plane)) * Extent[2];
+
+				if (lcDot3(Center, Plane) + Plane[3] > Radius)
+				{
+					mVisibleMeshes[MeshIdx] = 0;
+					break;
+				}
+			}
+		}
+	}
+}
+/*** LPub3D Mod end ***/
+
 void lcScene::DrawDebugNormals(lcContext* Context, const lcMesh* Mesh) const
 {
 	const lcVertex* const VertexBuffer = Mesh->GetVertexData();
@@ -167,6 +227,11 @@ void lcScene::DrawOpaqueMeshes(lcContext* Context, bool DrawLit, int PrimitiveTy
 		const lcMesh* Mesh = RenderMesh.Mesh;
 		const int LodIndex = RenderMesh.LodIndex;
 
+/*** LPub3D Mod - frustum culling ***/
+		if (!mVisibleMeshes[MeshIndex])
+			continue;
+/*** LPub3D Mod end ***/
+
 		if (!DrawFaded && RenderMesh.State == lcRenderMeshState::Faded)
 			continue;
 
@@ -382,6 +447,11 @@ void lcScene::DrawTranslucentMeshes(lcContext* Context, bool DrawLit, bool DrawF
 		const lcRenderMesh& RenderMesh = mRenderMeshes[MeshInstance.RenderMeshIndex];
 		const lcMesh* Mesh = RenderMesh.Mesh;
 
+/*** LPub3D Mod - frustum culling ***/
+		if (!mVisibleMeshes[MeshInstance.RenderMeshIndex])
+			continue;
+/*** LPub3D Mod end ***/
+
 		if (!DrawFaded && RenderMesh.State == lcRenderMeshState::Faded)
 			continue;
 
@@ -480,6 +550,10 @@ void lcScene::Draw(lcContext* Context) const
 
 	Context->SetViewMatrix(mViewMatrix);
 
+/*** LPub3D Mod - frustum culling ***/
+	UpdateVisibleMeshes(Context);
+/*** LPub3D Mod end ***/
+
 	const lcPreferences& Preferences = lcGetPreferences();
 	const bool DrawLines = Preferences.mDrawEdgeLines && Preferences.mLineWidth > 0.0f;
 	const bool DrawConditional = Preferences.mDrawConditionalLines && Preferences.mLineWidth > 0.0f;
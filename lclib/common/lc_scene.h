@@ -88,6 +88,13 @@ public:
 		mPreTranslucentCallback = Callback;
 	}
 
+/*** LPub3D Mod - frustum culling ***/
+	void SetFrustumCulling(bool FrustumCulling)
+	{
+		mFrustumCulling = FrustumCulling;
+	}
+/*** LPub3D Mod end ***/
+
 	lcMatrix44 ApplyActiveSubmodelTransform(const lcMatrix44& WorldMatrix) const
 	{
 		return !mActiveSubmodelInstance ? WorldMatrix : lcMul(WorldMatrix, mActiveSubmodelTransform);
@@ -111,6 +118,9 @@ protected:
 	void DrawTranslucentMeshes(lcContext* Context, bool DrawLit, bool DrawFadePrepass, bool DrawFaded, bool DrawNonFaded, lcLPubFade LPubFade = LC_NO_LPUB_FADE) const;
 /*** LPub3D Mod end ***/
 	void DrawDebugNormals(lcContext* Context, const lcMesh* Mesh) const;
+/*** LPub3D Mod - frustum culling ***/
+	void UpdateVisibleMeshes(lcContext* Context) const;
+/*** LPub3D Mod end ***/
 
 	lcMatrix44 mViewMatrix;
 	lcMatrix44 mActiveSubmodelTransform;
@@ -130,4 +140,8 @@ protected:
 	std::vector<int> mOpaqueMeshes;
 	std::vector<lcTranslucentMeshInstance> mTranslucentMeshes;
 	std::vector<const lcObject*> mInterfaceObjects;
+/*** LPub3D Mod - frustum culling ***/
+	bool mFrustumCulling;
+	mutable std::vector<char> mVisibleMeshes;
+/*** LPub3D Mod end ***/
 };
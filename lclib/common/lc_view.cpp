@@ -29,6 +29,12 @@ QPointer<lcFindReplaceWidget> lcView::mFindWidget;
 lcView* lcView::mLastFocusedView;
 std::vector<lcView*> lcView::mViews;
 
+/*** LPub3D Mod - native render session ***/
+bool lcView::mKeepRenderFramebuffer;
+QOpenGLContext* lcView::mKeptRenderFramebufferContext;
+std::unique_ptr<QOpenGLFramebufferObject> lcView::mKeptRenderFramebuffer;
+/*** LPub3D Mod end ***/
+
 /*** LPub3D Mod - preview widget for LPub3D ***/
 lcView::lcView(lcViewType ViewType, lcModel* Model, bool SubstituteView)
 	: mViewType(ViewType), mScene(new lcScene()), mModel(Model), mIsSubstituteView(SubstituteView)
@@ -218,6 +224,10 @@ void lcView::DestroyResources(lcContext* Context)
 
 	delete gGridTexture;
 	gGridTexture = nullptr;
+
+/*** LPub3D Mod - native render session ***/
+	ReleaseKeptRenderFramebuffer();
+/*** LPub3D Mod end ***/
 }
 
 void lcView::RemoveCamera()
@@ -867,6 +877,12 @@ bool lcView::BeginRenderToImage(int Width, int Height)
 	if (QSurfaceFormat::defaultFormat().samples() > 1)
 		Format.setSamples(QSurfaceFormat::defaultFormat().samples());
 
+/*** LPub3D Mod - native render session ***/
+	if (mKeptRenderFramebuffer && mKeptRenderFramebufferContext == QOpenGLContext::currentContext() &&
+		mKeptRenderFramebuffer->size() == QSize(TileWidth, TileHeight) && mKeptRenderFramebuffer->format() == Format)
+		mRenderFramebuffer = std::move(mKeptRenderFramebuffer);
+	else
+/*** LPub3D Mod end ***/
 	mRenderFramebuffer = std::unique_ptr<QOpenGLFramebufferObject>(new QOpenGLFramebufferObject(QSize(TileWidth, TileHeight), Format));
 
 	return mRenderFramebuffer->bind();
@@ -874,9 +890,51 @@ bool lcView::BeginRenderToImage(int Width, int Height)
 
 void lcView::EndRenderToImage()
 {
+/*** LPub3D Mod - native render session ***/
+	if (mKeepRenderFramebuffer && mRenderFramebuffer && mContext->IsOffscreen())
+	{
+		mRenderFramebuffer->release();
+		mKeptRenderFramebufferContext = QOpenGLContext::currentContext();
+		mKeptRenderFramebuffer = std::move(mRenderFramebuffer);
+		return;
+	}
+/*** LPub3D Mod end ***/
 	mRenderFramebuffer.reset();
 }
 
+/*** LPub3D Mod - native render session ***/
+// Keep the last offscreen image framebuffer so consecutive images of the
+// same size can render without allocating a new framebuffer.
+void lcView::SetKeepRenderFramebuffer(bool KeepFramebuffer)
+{
+	mKeepRenderFramebuffer = KeepFramebuffer;
+
+	if (!KeepFramebuffer)
+		ReleaseKeptRenderFramebuffer();
+}
+
+// The kept framebuffer is deleted while the offscreen context it was created in is current.
+void lcView::ReleaseKeptRenderFramebuffer()
+{
+	lcContext* Context = lcContext::GetGlobalOffscreenContext();
+
+	if (mKeptRenderFramebuffer && Context)
+	{
+		QOpenGLContext* CurrentContext = QOpenGLContext::currentContext();
+		QSurface* CurrentSurface = CurrentContext ? CurrentContext->surface() : nullptr;
+
+		Context->MakeCurrent();
+		mKeptRenderFramebuffer.reset();
+
+		if (CurrentContext)
+			CurrentContext->makeCurrent(CurrentSurface);
+	}
+
+	mKeptRenderFramebuffer.reset();
+	mKeptRenderFramebufferContext = nullptr;
+}
+/*** LPub3D Mod end ***/
+
 QImage lcView::GetRenderImage() const
 {
 	return mRenderImage;
@@ -297,6 +297,10 @@ public:
 
 	bool BeginRenderToImage(int Width, int Height);
 	void EndRenderToImage();
+/*** LPub3D Mod - native render session ***/
+	static void SetKeepRenderFramebuffer(bool KeepFramebuffer);
+	static void ReleaseKeptRenderFramebuffer();
+/*** LPub3D Mod end ***/
 	QImage GetRenderImage() const;
 	void BindRenderFramebuffer();
 	void UnbindRenderFramebuffer();
@@ -388,4 +392,10 @@ protected:
 /*** LPub3D Mod - preview widget for LPub3D ***/
 	bool mIsSubstituteView = false;
 /*** LPub3D Mod end ***/
+
+/*** LPub3D Mod - native render session ***/
+	static bool mKeepRenderFramebuffer;
+	static QOpenGLContext* mKeptRenderFramebufferContext;
+	static std::unique_ptr<QOpenGLFramebufferObject> mKeptRenderFramebuffer;
+/*** LPub3D Mod end ***/
 };
@@ -4,6 +4,7 @@
 #include "lc_math.h"
 #include <zlib.h>
 #include <time.h>
+#include <QtEndian>
 
 #if MAX_MEM_LEVEL >= 8
 #  define DEF_MEM_LEVEL 8
@@ -11,9 +12,23 @@
 #  define DEF_MEM_LEVEL  MAX_MEM_LEVEL
 #endif
 
+// Names are compared without case, the first entry wins for duplicate names.
+static std::string lcZipFileKey(const char* FileName)
+{
+	std::string Key(FileName);
+
+	for (char& Char : Key)
+		if (Char >= 'A' && Char <= 'Z')
+			Char += 'a' - 'A';
+
+	return Key;
+}
+
 lcZipFile::lcZipFile()
 {
 	mModified = false;
+	mData = nullptr;
+	mDataSize = 0;
 }
 
 lcZipFile::~lcZipFile()
@@ -40,9 +55,27 @@ bool lcZipFile::OpenRead(std::unique_ptr<lcFile> File)
 		return false;
 	}
 
+	MapFile();
+
 	return true;
 }
 
+// Give the extraction threads direct access to the archive contents so
+// they can read entries concurrently instead of sharing the file position.
+void lcZipFile::MapFile()
+{
+	if (lcMemFile* MemFile = dynamic_cast<lcMemFile*>(mFile.get()))
+	{
+		mData = MemFile->mBuffer;
+		mDataSize = MemFile->mFileSize;
+	}
+	else if (lcDiskFile* DiskFile = dynamic_cast<lcDiskFile*>(mFile.get()))
+	{
+		mData = DiskFile->Map();
+		mDataSize = mData ? DiskFile->GetLength() : 0;
+	}
+}
+
 bool lcZipFile::OpenWrite(const QString& FileName)
 {
 	std::unique_ptr<lcDiskFile> File(new lcDiskFile(FileName));
@@ -564,24 +597,154 @@ bool lcZipFile::ReadCentralDir()
 		mFile->Seek(Seek, SEEK_CUR);
 	}
 
+	mFileIndex.clear();
+	mFileIndex.reserve(mFiles.size());
+
+	for (quint32 FileIdx = 0; FileIdx < mFiles.size(); FileIdx++)
+		mFileIndex.emplace(lcZipFileKey(mFiles[FileIdx].file_name), FileIdx);
+
 	return true;
 }
 
 bool lcZipFile::ExtractFile(const char* FileName, lcMemFile& File, quint32 MaxLength)
 {
-	for (quint32 FileIdx = 0; FileIdx < mFiles.size(); FileIdx++)
+	const auto FileIt = mFileIndex.find(lcZipFileKey(FileName));
+
+	if (FileIt == mFileIndex.end())
+		return false;
+
+	return ExtractFile(FileIt->second, File, MaxLength);
+}
+
+bool lcZipFile::CheckMappedFileHeader(const lcZipFileInfo& FileInfo, quint32* SizeVar) const
+{
+	const quint64 Offset = FileInfo.offset_curfile + mBytesBeforeZipFile;
+
+	if (Offset + 0x1e > mDataSize)
+		return false;
+
+	const quint8* Header = mData + Offset;
+	const quint16 Flags = qFromLittleEndian<quint16>(Header + 6);
+
+	if (qFromLittleEndian<quint32>(Header) != 0x04034b50)
+		return false;
+
+	if (qFromLittleEndian<quint16>(Header + 8) != FileInfo.compression_method)
+		return false;
+
+	if (FileInfo.compression_method != 0 && FileInfo.compression_method != Z_DEFLATED)
+		return false;
+
+	const quint32 Crc = qFromLittleEndian<quint32>(Header + 14);
+	if ((Crc != FileInfo.crc) && ((Flags & 8)==0))
+		return false;
+
+	const quint32 CompressedSize = qFromLittleEndian<quint32>(Header + 18);
+	if (CompressedSize != 0xffffffffU && (CompressedSize != FileInfo.compressed_size) && ((Flags & 8)==0))
+		return false;
+
+	const quint32 UncompressedSize = qFromLittleEndian<quint32>(Header + 22);
+	if (UncompressedSize != 0xffffffffU && (UncompressedSize != FileInfo.uncompressed_size) && ((Flags & 8)==0))
+		return false;
+
+	const quint16 SizeFilename = qFromLittleEndian<quint16>(Header + 26);
+	if (SizeFilename != FileInfo.size_filename)
+		return false;
+
+	*SizeVar = SizeFilename + qFromLittleEndian<quint16>(Header + 28);
+
+	return true;
+}
+
+// Inflates straight from the mapped archive, no state is shared between callers.
+bool lcZipFile::ExtractMappedFile(const lcZipFileInfo& FileInfo, lcMemFile& File, quint32 MaxLength) const
+{
+	quint32 SizeVar;
+
+	if (!CheckMappedFileHeader(FileInfo, &SizeVar))
+		return false;
+
+	const quint64 PosInZipfile = FileInfo.offset_curfile + mBytesBeforeZipFile + 0x1e + SizeVar;
+
+	if (PosInZipfile + FileInfo.compressed_size > mDataSize)
+		return false;
+
+	quint32 Length = lcMin((quint32)FileInfo.uncompressed_size, MaxLength);
+	File.SetLength(Length);
+	File.Seek(0, SEEK_SET);
+
+	if (FileInfo.compression_method == 0)
+	{
+		const quint32 DoCopy = (quint32)lcMin((quint64)Length, FileInfo.compressed_size);
+
+		if (Length && !DoCopy)
+			return false;
+
+		memcpy(File.mBuffer, mData + PosInZipfile, DoCopy);
+
+		return true;
+	}
+
+	z_stream Stream;
+	quint32 Crc32 = 0;
+	quint64 RestReadUncompressed = FileInfo.uncompressed_size;
+
+	Stream.zalloc = (alloc_func)0;
+	Stream.zfree = (free_func)0;
+	Stream.opaque = (voidpf)0;
+	Stream.next_in = (Bytef*)(mData + PosInZipfile);
+	Stream.avail_in = (uInt)FileInfo.compressed_size;
+	Stream.total_out = 0;
+
+	if (inflateInit2(&Stream, -MAX_WBITS) != Z_OK)
+		return false;
+
+	Stream.next_out = (Bytef*)File.mBuffer;
+	Stream.avail_out = Length;
+
+	while (Stream.avail_out > 0)
 	{
-		lcZipFileInfo& FileInfo = mFiles[FileIdx];
+		const quint64 TotalOutBefore = Stream.total_out;
+		const Bytef* bufBefore = Stream.next_out;
+
+		int err = inflate(&Stream, Z_SYNC_FLUSH);
 
-		if (!qstricmp(FileInfo.file_name, FileName))
-			return ExtractFile(FileIdx, File, MaxLength);
+		if ((err >= 0) && (Stream.msg != nullptr))
+			err = Z_DATA_ERROR;
+
+		const quint64 OutThis = Stream.total_out - TotalOutBefore;
+
+		Crc32 = crc32(Crc32, bufBefore, (uInt)(OutThis));
+
+		RestReadUncompressed -= OutThis;
+
+		if (err != Z_OK)
+		{
+			inflateEnd(&Stream);
+
+			if (RestReadUncompressed == 0)
+			{
+				if (Crc32 != FileInfo.crc)
+					return false;
+			}
+
+			if (err == Z_STREAM_END)
+				return (Stream.total_out == 0) ? false : true;
+
+			return false;
+		}
 	}
 
-	return false;
+	inflateEnd(&Stream);
+
+	return true;
 }
 
 bool lcZipFile::ExtractFile(quint32 FileIndex, lcMemFile& File, quint32 MaxLength)
 {
+	if (mData)
+		return ExtractMappedFile(mFiles[FileIndex], File, MaxLength);
+
 	QMutexLocker Lock(&mMutex);
 
 	quint32 SizeVar;
@@ -74,9 +74,15 @@ protected:
 	quint64 SearchCentralDir();
 	quint64 SearchCentralDir64();
 	bool CheckFileCoherencyHeader(int FileIndex, quint32* SizeVar, quint64* OffsetLocalExtraField, quint32* SizeLocalExtraField);
+	void MapFile();
+	bool CheckMappedFileHeader(const lcZipFileInfo& FileInfo, quint32* SizeVar) const;
+	bool ExtractMappedFile(const lcZipFileInfo& FileInfo, lcMemFile& File, quint32 MaxLength) const;
 
 	QMutex mMutex;
 	std::unique_ptr<lcFile> mFile;
+	const quint8* mData;
+	quint64 mDataSize;
+	std::unordered_map<std::string, quint32> mFileIndex;
 
 	bool mModified;
 	bool mZip64;
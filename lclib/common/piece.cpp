@@ -83,6 +83,9 @@ lcPiece::~lcPiece()
 	}
 
 	delete mMesh;
+/*** LPub3D Mod - picking tree ***/
+	lcPickBoxesChanged();
+/*** LPub3D Mod end ***/
 }
 
 void lcPiece::SetPieceInfo(PieceInfo* Info, const QString& ID, bool Wait)
@@ -92,6 +95,9 @@ void lcPiece::SetPieceInfo(PieceInfo* Info, const QString& ID, bool Wait)
 	mPieceInfo = Info;
 	if (mPieceInfo)
 		Library->LoadPieceInfo(mPieceInfo, Wait, true);
+/*** LPub3D Mod - picking tree ***/
+	lcPickBoxesChanged();
+/*** LPub3D Mod end ***/
 
 	if (!ID.isEmpty())
 		mID = ID;
@@ -1208,6 +1214,9 @@ void lcPiece::MoveSelected(lcStep Step, bool AddKey, const lcVector3& Distance)
 		SetPosition(Position, Step, AddKey);
 
 		mModelWorld.SetTranslation(Position);
+/*** LPub3D Mod - picking tree ***/
+		lcPickBoxesChanged();
+/*** LPub3D Mod end ***/
 	}
 	else if (Section >= LC_PIECE_SECTION_CONTROL_POINT_FIRST)
 	{
@@ -1552,6 +1561,38 @@ const lcBoundingBox& lcPiece::GetBoundingBox() const
 		return mMesh->mBoundingBox;
 }
 
+/*** LPub3D Mod - picking tree ***/
+// Local box containing everything the ray and box tests can hit: the piece
+// and part meshes and the control points of flexible parts.
+lcBoundingBox lcPiece::GetPickBoundingBox() const
+{
+	lcBoundingBox BoundingBox = mPieceInfo->GetBoundingBox();
+
+	if (mMesh)
+	{
+		BoundingBox.Min = lcMin(BoundingBox.Min, mMesh->mBoundingBox.Min);
+		BoundingBox.Max = lcMax(BoundingBox.Max, mMesh->mBoundingBox.Max);
+	}
+
+	if (mPieceInfo->GetSynthInfo())
+	{
+		// control point boxes can be rotated, their half diagonal bounds them
+		const float Size = LC_PIECE_CONTROL_POINT_SIZE * 1.7321f;
+		const lcVector3 Extent(Size, Size, Size);
+
+		for (const lcPieceControlPoint& ControlPoint : mControlPoints)
+		{
+			const lcVector3 Position = ControlPoint.Transform.GetTranslation();
+
+			BoundingBox.Min = lcMin(BoundingBox.Min, Position - Extent);
+			BoundingBox.Max = lcMax(BoundingBox.Max, Position + Extent);
+		}
+	}
+
+	return BoundingBox;
+}
+/*** LPub3D Mod end ***/
+
 void lcPiece::CompareBoundingBox(lcVector3& Min, lcVector3& Max) const
 {
 	if (!mMesh)
@@ -1582,7 +1623,15 @@ void lcPiece::UpdatePosition(lcStep Step)
 	mPosition.Update(Step);
 	mRotation.Update(Step);
 
-	mModelWorld = lcMatrix44(mRotation, mPosition);
+/*** LPub3D Mod - picking tree ***/
+	const lcMatrix44 ModelWorld(mRotation, mPosition);
+
+	if (memcmp(&ModelWorld, &mModelWorld, sizeof(lcMatrix44)))
+	{
+		mModelWorld = ModelWorld;
+		lcPickBoxesChanged();
+	}
+/*** LPub3D Mod end ***/
 }
 
 void lcPiece::UpdateMesh()
@@ -1590,6 +1639,9 @@ void lcPiece::UpdateMesh()
 	delete mMesh;
 	const lcSynthInfo* SynthInfo = mPieceInfo->GetSynthInfo();
 	mMesh = SynthInfo ? SynthInfo->CreateMesh(mControlPoints) : nullptr;
+/*** LPub3D Mod - picking tree ***/
+	lcPickBoxesChanged();
+/*** LPub3D Mod end ***/
 }
 
 /*** LPub3D Mod - LPUB meta properties ***/
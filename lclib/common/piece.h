@@ -259,6 +259,9 @@ public:
 	void GetModelParts(const lcMatrix44& WorldMatrix, int DefaultColorIndex, std::vector<lcModelPartsEntry>& ModelParts) const;
 	void Initialize(const lcMatrix44& WorldMatrix, lcStep Step);
 	const lcBoundingBox& GetBoundingBox() const;
+/*** LPub3D Mod - picking tree ***/
+	lcBoundingBox GetPickBoundingBox() const;
+/*** LPub3D Mod end ***/
 	void CompareBoundingBox(lcVector3& Min, lcVector3& Max) const;
 	void SetPieceInfo(PieceInfo* Info, const QString& ID, bool Wait);
 	bool SetPieceId(PieceInfo* Info);
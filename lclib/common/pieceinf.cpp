@@ -36,6 +36,10 @@ PieceInfo::~PieceInfo()
 
 	if (mState == lcPieceInfoState::Loaded)
 		Unload();
+/*** LPub3D Mod - stud style meshes ***/
+	else
+		ReleaseStudStyleMeshes();
+/*** LPub3D Mod end ***/
 }
 
 void PieceInfo::SetMesh(lcMesh* Mesh)
@@ -43,6 +47,9 @@ void PieceInfo::SetMesh(lcMesh* Mesh)
 	mBoundingBox = Mesh->mBoundingBox;
 	ReleaseMesh();
 	mMesh = Mesh;
+/*** LPub3D Mod - picking tree ***/
+	lcPickBoxesChanged();
+/*** LPub3D Mod end ***/
 }
 
 void PieceInfo::SetPlaceholder()
@@ -211,29 +218,81 @@ void PieceInfo::Load()
 	mState = lcPieceInfoState::Loaded;
 }
 
-void PieceInfo::ReleaseMesh()
+/*** LPub3D Mod - stud style meshes ***/
+static void lcReleaseMesh(lcMesh* Mesh)
 {
-	if (mMesh)
+	if (Mesh)
 	{
 		for (int LodIdx = 0; LodIdx < LC_NUM_MESH_LODS; LodIdx++)
 		{
-			for (int SectionIdx = 0; SectionIdx < mMesh->mLods[LodIdx].NumSections; SectionIdx++)
+			for (int SectionIdx = 0; SectionIdx < Mesh->mLods[LodIdx].NumSections; SectionIdx++)
 			{
-				lcMeshSection& Section = mMesh->mLods[LodIdx].Sections[SectionIdx];
+				lcMeshSection& Section = Mesh->mLods[LodIdx].Sections[SectionIdx];
 
 				if (Section.Texture)
 					Section.Texture->Release();
 			}
 		}
 
-		delete mMesh;
+		delete Mesh;
+	}
+}
+
+void PieceInfo::ReleaseMesh()
+{
+	lcReleaseMesh(mMesh);
+	mMesh = nullptr;
+}
+
+void PieceInfo::ReleaseStudStyleMeshes()
+{
+	for (const auto& [StyleKey, Mesh] : mStudStyleMeshes)
+		lcReleaseMesh(Mesh);
+
+	mStudStyleMeshes.clear();
+}
+
+// Keeps the current mesh as the variant of the old stud style and installs
+// the variant of the new stud style if one was kept. Returns false when the
+// piece has no mesh for the new style and must be loaded again.
+bool PieceInfo::SwapStudStyleMesh(int OldStyleKey, int NewStyleKey)
+{
+	if (mMesh)
+	{
+		mMesh->mVertexCacheOffset = -1;
+		mMesh->mIndexCacheOffset = -1;
+
+		lcMesh*& OldMesh = mStudStyleMeshes[OldStyleKey];
+		lcReleaseMesh(OldMesh);
+		OldMesh = mMesh;
 		mMesh = nullptr;
 	}
+
+	const auto MeshIt = mStudStyleMeshes.find(NewStyleKey);
+
+	if (MeshIt == mStudStyleMeshes.end())
+	{
+		mState = lcPieceInfoState::Unloaded;
+		return false;
+	}
+
+	SetMesh(MeshIt->second);
+	mStudStyleMeshes.erase(MeshIt);
+	mState = lcPieceInfoState::Loaded;
+
+	// the kept mesh is not in the library vertex and index buffers
+	lcGetPiecesLibrary()->mBuffersDirty = true;
+
+	return true;
 }
+/*** LPub3D Mod end ***/
 
 void PieceInfo::Unload()
 {
 	ReleaseMesh();
+/*** LPub3D Mod - stud style meshes ***/
+	ReleaseStudStyleMeshes();
+/*** LPub3D Mod end ***/
 	mState = lcPieceInfoState::Unloaded;
 	mModel = nullptr;
 
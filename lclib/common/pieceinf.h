@@ -2,6 +2,9 @@
 
 #include <stdio.h>
 #include "lc_math.h"
+/*** LPub3D Mod - picking tree ***/
+#include "lc_bvh.h"
+/*** LPub3D Mod end ***/
 
 enum class lcPieceInfoType
 {
@@ -52,6 +55,9 @@ public:
 	{
 		mBoundingBox.Min = Min;
 		mBoundingBox.Max = Max;
+/*** LPub3D Mod - picking tree ***/
+		lcPickBoxesChanged();
+/*** LPub3D Mod end ***/
 	}
 
 	lcSynthInfo* GetSynthInfo() const
@@ -203,6 +209,9 @@ public:
 
 	void Load();
 	void Unload();
+/*** LPub3D Mod - stud style meshes ***/
+	bool SwapStudStyleMesh(int OldStyleKey, int NewStyleKey);
+/*** LPub3D Mod end ***/
 
 public:
 	char mFileName[LC_PIECE_NAME_LEN];
@@ -218,6 +227,9 @@ public:
 
 protected:
 	void ReleaseMesh();
+/*** LPub3D Mod - stud style meshes ***/
+	void ReleaseStudStyleMeshes();
+/*** LPub3D Mod end ***/
 
 /*** LPub3D Mod - project piece ***/
 	bool mProjectPiece = false;
@@ -227,6 +239,9 @@ protected:
 	lcModel* mModel = nullptr;
 	Project* mProject = nullptr;
 	lcMesh* mMesh = nullptr;
+/*** LPub3D Mod - stud style meshes ***/
+	std::map<int, lcMesh*> mStudStyleMeshes;
+/*** LPub3D Mod end ***/
 	lcBoundingBox mBoundingBox;
 	lcSynthInfo* mSynthInfo = nullptr;
 	lcTrainTrackInfo* mTrainTrackInfo = nullptr;
@@ -495,6 +495,28 @@ bool Project::Load(const QString& FileName, bool ShowErrors, const QString &Step
 	return Load(FileName, StepKey, 0/*Options::PLI*/, ShowErrors);
 }
 
+/*** LPub3D Mod - native render session ***/
+// Load the content of FileName from memory instead of reading the file.
+// Content identical to the previous load keeps the parsed models.
+bool Project::Load(const QString& FileName, const QByteArray& FileData, int Type)
+{
+	if (!mModels.empty() && Type == mImageType && FileData == mLoadedFileData)
+	{
+		SetFileName(FileName);
+		return true;
+	}
+
+	mLoadFileData = FileData;
+	const bool Loaded = Load(FileName, QString(), Type, false/*ShowErrors*/);
+	mLoadFileData.clear();
+
+	if (Loaded)
+		mLoadedFileData = FileData;
+
+	return Loaded;
+}
+/*** LPub3D Mod end ***/
+
 bool Project::Load(const QString& LoadFileName, const QString& StepKey, int Type, bool ShowErrors)
 {
 	mImageType = Type;
@@ -584,6 +606,13 @@ bool Project::Load(const QString& LoadFileName, const QString& StepKey, int Type
 	};
 
 	QByteArray FileData;
+/*** LPub3D Mod - native render session ***/
+	if (!FileName.isEmpty() && !mLoadFileData.isEmpty())
+	{
+		FileData = mLoadFileData;
+	}
+	else
+/*** LPub3D Mod end ***/
 	if (!FileName.isEmpty() && !IsLPubModel)
 	{
 		QFile File(FileName);
@@ -648,6 +677,9 @@ bool Project::Load(const QString& LoadFileName, const QString& StepKey, int Type
 	}
 
 	mModels.clear();
+/*** LPub3D Mod - native render session ***/
+	mLoadedFileData.clear();
+/*** LPub3D Mod end ***/
 	SetFileName(FileName);
 	QFileInfo FileInfo(FileName);
 	QString Extension = FileInfo.suffix().toLower();
@@ -194,6 +194,9 @@ public:
 /*** LPub3D Mod end ***/
 /*** LPub3D Mod - viewer step key ***/
 	bool Load(const QString& FileName, bool ShowErrors, const QString &StepKey = "");
+/*** LPub3D Mod end ***/
+/*** LPub3D Mod - native render session ***/
+	bool Load(const QString& FileName, const QByteArray& FileData, int Type);
 /*** LPub3D Mod end ***/
 	bool Save(const QString& FileName);
 	bool Save(QTextStream& Stream);
@@ -230,6 +233,10 @@ protected:
 /*** LPub3D Mod end ***/
 /*** LPub3D Mod - viewer step key ***/
 	QString mStepKey;
+/*** LPub3D Mod end ***/
+/*** LPub3D Mod - native render session ***/
+	QByteArray mLoadFileData;
+	QByteArray mLoadedFileData;
 /*** LPub3D Mod end ***/
 	bool mModified;
 	QString mFileName;
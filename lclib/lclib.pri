@@ -16,6 +16,7 @@ HEADERS += \
     common/lc_arraydialog.h \
     common/lc_blenderpreferences.h \
     common/lc_bricklink.h \
+    common/lc_bvh.h \
     common/lc_category.h \
     common/lc_categorydialog.h \
     common/lc_collapsiblewidget.h \
@@ -94,6 +95,7 @@ SOURCES += \
     common/lc_arraydialog.cpp \
     common/lc_blenderpreferences.cpp \
     common/lc_bricklink.cpp \
+    common/lc_bvh.cpp \
     common/lc_category.cpp \
     common/lc_categorydialog.cpp \
     common/lc_collapsiblewidget.cpp \
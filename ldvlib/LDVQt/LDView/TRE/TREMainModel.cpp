@@ -117,6 +117,10 @@ TREMainModel::TREMainModel(void)
 	, m_curGeomModel(NULL)
 	, m_texClampMode(GL_CLAMP)
 	, m_seamWidth(0.5f)
+// LPub3D Mod - parallel part smoothing
+	, m_nextSmoothPart(0)
+	, m_queueSmoothParts(false)
+// LPub3D Mod End
 #if defined(USE_CPP11) || !defined(_NO_TRE_THREADS)
 #ifdef USE_CPP11
 	, m_threads(NULL)
@@ -127,6 +131,9 @@ TREMainModel::TREMainModel(void)
 	, m_workerCondition(NULL)
 	, m_sortCondition(NULL)
 	, m_conditionalsCondition(NULL)
+// LPub3D Mod - parallel part smoothing
+	, m_smoothMutex(NULL)
+// LPub3D Mod End
 	, m_exiting(false)
 #endif // !_NO_TRE_THREADS
 {
@@ -664,7 +671,22 @@ int TREMainModel::getNumBackgroundTasks(void)
 	return numTasks;
 }
 
+// LPub3D Mod - parallel part smoothing
 int TREMainModel::getNumWorkerThreads(void)
+{
+	int numProcessors = getNumProcessors();
+
+	if (numProcessors > 1)
+	{
+		return std::min(numProcessors - 1, getNumBackgroundTasks());
+	}
+	return 0;
+}
+
+// Returns the number of processors available to worker threads, or 0 if
+// threads are disabled.
+int TREMainModel::getNumProcessors(void)
+// LPub3D Mod End
 {
 #if defined(USE_CPP11) || !defined(_NO_TRE_THREADS)
 	if (getMultiThreadedFlag())
@@ -712,10 +734,9 @@ int TREMainModel::getNumWorkerThreads(void)
 #endif // _SC_NPROCESSORS_ONLN
 #endif // _QT
 #endif // !USE_CPP11
-		if (numProcessors > 1)
-		{
-			return std::min(numProcessors - 1, getNumBackgroundTasks());
-		}
+// LPub3D Mod - parallel part smoothing
+		return numProcessors;
+// LPub3D Mod End
 	}
 #endif // USE_CPP11 || !_NO_TRE_THREADS
 	return 0;
@@ -824,6 +845,30 @@ bool TREMainModel::workerThreadDoWork(_ScopedLock &lock)
 	return false;
 }
 
+// LPub3D Mod - parallel part smoothing
+void TREMainModel::smoothPartsProc(void)
+{
+	while (true)
+	{
+		size_t index;
+
+		{
+			ScopedLock lock(*m_smoothMutex);
+
+			if (m_nextSmoothPart >= m_smoothParts.size())
+			{
+				return;
+			}
+			index = m_nextSmoothPart++;
+		}
+		for (int i = 0; i < m_smoothPartCounts[index]; i++)
+		{
+			m_smoothParts[index]->smooth();
+		}
+	}
+}
+// LPub3D Mod End
+
 void TREMainModel::workerThreadProc(void)
 {
 	ScopedLock lock(*m_workerMutex);
@@ -2440,6 +2485,101 @@ void TREMainModel::deleteGLTexmaps(void)
 	}
 }
 
+// LPub3D Mod - parallel part smoothing
+/*
+Smoothing a part only reads and updates the part's own shapes, so the parts
+finished here are flattened in the usual order on this thread, and their
+smoothing is queued and run on worker threads. Each queued part is smoothed
+as many times as it was finished. Flattening appends to the shared vertex
+stores, so the queue only runs while no flattening is in progress, and it is
+run before flattening a part that copies other parts' geometry. This gives
+the same output as finishing the parts one after another.
+*/
+void TREMainModel::finishParts(void)
+{
+	m_queueSmoothParts = getNumProcessors() > 1;
+	TREModel::finishParts();
+	finishSmoothParts();
+	m_queueSmoothParts = false;
+}
+
+void TREMainModel::smoothPart(TREModel *model)
+{
+	if (!m_queueSmoothParts)
+	{
+		model->smooth();
+		return;
+	}
+	std::map<TREModel *, size_t>::iterator it =
+		m_smoothPartIndices.find(model);
+
+	if (it == m_smoothPartIndices.end())
+	{
+		m_smoothPartIndices[model] = m_smoothParts.size();
+		m_smoothParts.push_back(model);
+		m_smoothPartCounts.push_back(1);
+	}
+	else
+	{
+		m_smoothPartCounts[it->second]++;
+	}
+}
+
+void TREMainModel::finishSmoothParts(void)
+{
+	if (m_smoothParts.empty())
+	{
+		return;
+	}
+#if defined(USE_CPP11) || !defined(_NO_TRE_THREADS)
+	int threadCount = std::min(getNumProcessors(), (int)m_smoothParts.size());
+
+	if (threadCount > 1)
+	{
+		m_nextSmoothPart = 0;
+#ifdef USE_CPP11
+		std::vector<std::thread> threads;
+
+		m_smoothMutex = new std::mutex;
+		for (int i = 0; i < threadCount; i++)
+		{
+			threads.emplace_back(&TREMainModel::smoothPartsProc, this);
+		}
+		for (size_t i = 0; i < threads.size(); i++)
+		{
+			threads[i].join();
+		}
+#else
+		boost::thread_group threadGroup;
+
+		m_smoothMutex = new boost::mutex;
+		for (int i = 0; i < threadCount; i++)
+		{
+			threadGroup.create_thread(
+				boost::bind(&TREMainModel::smoothPartsProc, this));
+		}
+		threadGroup.join_all();
+#endif
+		delete m_smoothMutex;
+		m_smoothMutex = NULL;
+	}
+	else
+#endif // USE_CPP11 || !_NO_TRE_THREADS
+	{
+		for (size_t i = 0; i < m_smoothParts.size(); i++)
+		{
+			for (int j = 0; j < m_smoothPartCounts[i]; j++)
+			{
+				m_smoothParts[i]->smooth();
+			}
+		}
+	}
+	m_smoothParts.clear();
+	m_smoothPartCounts.clear();
+	m_smoothPartIndices.clear();
+}
+// LPub3D Mod End
+
 void TREMainModel::finish(void)
 {
 	// transferTexmapped() has to happen before finishParts does any part
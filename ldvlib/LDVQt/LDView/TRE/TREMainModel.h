@@ -420,6 +420,11 @@ public:
 	static void setRawStudTextureData(TCByte *data, long length);
 	static TCImageArray *getStudTextures(void) { return sm_studTextures; }
 	static unsigned getStudTextureID(void) { return sm_studTextureID; }
+// LPub3D Mod - parallel part smoothing
+	virtual void finishParts(void);
+	void smoothPart(TREModel *model);
+	void finishSmoothParts(void);
+// LPub3D Mod End
 protected:
 	typedef enum
 	{
@@ -505,8 +510,14 @@ protected:
 	template <class _ScopedLock> bool workerThreadDoWork(_ScopedLock &lock);
 	template <class _ScopedLock> void nextConditionalsStep(_ScopedLock &lock);
 	void workerThreadProc(void);
+// LPub3D Mod - parallel part smoothing
+	void smoothPartsProc(void);
+// LPub3D Mod End
 #endif // USE_CPP11 || !_NO_TRE_THREADS
 	void launchWorkerThreads(void);
+// LPub3D Mod - parallel part smoothing
+	int getNumProcessors(void);
+// LPub3D Mod End
 	int getNumWorkerThreads(void);
 	int getNumBackgroundTasks(void);
 	void triggerWorkerThreads(void);
@@ -568,6 +579,15 @@ protected:
 	TexmapInfoList m_mainTexmapInfos;
 	GLint m_texClampMode;
 	TCFloat m_seamWidth;
+// LPub3D Mod - parallel part smoothing
+	// Parts waiting to be smoothed, with the number of times each one was
+	// finished since the queue was last run.
+	std::vector<TREModel *> m_smoothParts;
+	std::vector<int> m_smoothPartCounts;
+	std::map<TREModel *, size_t> m_smoothPartIndices;
+	size_t m_nextSmoothPart;
+	bool m_queueSmoothParts;
+// LPub3D Mod End
 #if defined(USE_CPP11) || !defined(_NO_TRE_THREADS)
 #ifdef USE_CPP11
 	std::vector<std::thread> *m_threads;
@@ -575,12 +595,18 @@ protected:
 	std::condition_variable *m_workerCondition;
 	std::condition_variable *m_sortCondition;
 	std::condition_variable *m_conditionalsCondition;
+// LPub3D Mod - parallel part smoothing
+	std::mutex *m_smoothMutex;
+// LPub3D Mod End
 #else
 	boost::thread_group *m_threadGroup;
 	boost::mutex *m_workerMutex;
 	boost::condition *m_workerCondition;
 	boost::condition *m_sortCondition;
 	boost::condition *m_conditionalsCondition;
+// LPub3D Mod - parallel part smoothing
+	boost::mutex *m_smoothMutex;
+// LPub3D Mod End
 #endif
 	bool m_exiting;
 #endif // USE_CPP11 || !_NO_TRE_THREADS
@@ -1599,9 +1599,9 @@ int TREModel::getConditionalLine(TREConditionalMap &conditionalMap,
 
 /*
 This function fills edgeMap with all the edge lines, checking the points at each
-end of each conditional line, and then creating an entry for the smaller point,
-inserting the other point into the set of points that is the value. When looking
-up points later, the smaller point is always used as the key for the lookup.
+end of each conditional line, and then inserting the pair of points with the
+smaller point first. When looking up points later, the smaller point is always
+used as the first point of the lookup.
 */
 void TREModel::fillEdgeMap(TREEdgeMap &edgeMap)
 {
@@ -1632,14 +1632,16 @@ void TREModel::fillEdgeMap(TREEdgeMap &edgeMap, TREShapeGroup *shapeGroup)
 				TREVertexKey vertex0Key(vertex0);
 				TREVertexKey vertex1Key(vertex1);
 
+// LPub3D Mod - hashed vertex keys
 				if (vertex0Key < vertex1Key)
 				{
-					edgeMap[vertex0Key].insert(vertex1Key);
+					edgeMap.insert(TREEdgeKey(vertex0Key, vertex1Key));
 				}
 				else if (vertex1Key < vertex0Key)
 				{
-					edgeMap[vertex1Key].insert(vertex0Key);
+					edgeMap.insert(TREEdgeKey(vertex1Key, vertex0Key));
 				}
+// LPub3D Mod End
 				else
 				{
 					TCVector length = TCVector(vertex0.v) - TCVector(vertex1.v);
@@ -1661,18 +1663,13 @@ bool TREModel::findEdge(const TREEdgeMap& edgeMap,
 		// edgeMap only contains keys for the lesser of each vertex pair.
 		return findEdge(edgeMap, vertex1Key, vertex0Key);
 	}
+// LPub3D Mod - hashed vertex keys
 	else
 	{
-		TREEdgeMap::const_iterator it0 = edgeMap.find(vertex0Key);
-		if (it0 != edgeMap.end())
-		{
-			TREVertexKeySet::const_iterator it1 = it0->second.find(vertex1Key);
-			if (it1 != it0->second.end()) {
-				return true;
-			}
-		}
+		return edgeMap.find(TREEdgeKey(vertex0Key, vertex1Key)) !=
+			edgeMap.end();
 	}
-	return false;
+// LPub3D Mod End
 }
 
 /*
@@ -4298,14 +4295,43 @@ void TREModel::finishPart(void)
 {
 	if (m_mainModel->getFlattenPartsFlag())
 	{
+// LPub3D Mod - parallel part smoothing
+		// Flattening copies the geometry of any sub-parts, so their queued
+		// smoothing has to be done first.
+		if (hasPartSubModels())
+		{
+			m_mainModel->finishSmoothParts();
+		}
+// LPub3D Mod End
 		flatten();
 	}
 	if (m_mainModel->getSmoothCurvesFlag())
 	{
-		smooth();
+// LPub3D Mod - parallel part smoothing
+		m_mainModel->smoothPart(this);
+// LPub3D Mod End
 	}
 }
 
+// LPub3D Mod - parallel part smoothing
+bool TREModel::hasPartSubModels(void)
+{
+	if (m_subModels != NULL)
+	{
+		for (size_t i = 0; i < m_subModels->getCount(); i++)
+		{
+			TREModel *model = (*m_subModels)[i]->getModel();
+
+			if (model->isPart() || model->hasPartSubModels())
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+// LPub3D Mod End
+
 void TREModel::shrinkParts(void)
 {
 	if (!isPart())
@@ -10,6 +10,10 @@
 #include <TRE/TRESmoother.h>
 #include <TCFoundation/TCVector.h>
 #include <TCFoundation/TCStlIncludes.h>
+// LPub3D Mod - hashed vertex keys
+#include <unordered_map>
+#include <unordered_set>
+// LPub3D Mod End
 
 struct TREVertex;
 class TRESubModel;
@@ -37,9 +41,12 @@ typedef TCTypedObjectArray<TRESubModel> TRESubModelArray;
 typedef TCTypedObjectArray<TREShapeGroup> TREShapeGroupArray;
 typedef TCTypedObjectArray<TREColoredShapeGroup> TREColoredShapeGroupArray;
 typedef TCTypedObjectArray<TRENormalInfo> TRENormalInfoArray;
-typedef std::map<TREVertexKey, TRESmoother> TREConditionalMap;
-typedef std::set<TREVertexKey> TREVertexKeySet;
-typedef std::map<TREVertexKey, TREVertexKeySet> TREEdgeMap;
+// LPub3D Mod - hashed vertex keys
+// Node based, so TRENormalInfo can keep pointers to the smoothers.
+typedef std::unordered_map<TREVertexKey, TRESmoother, TREVertexKeyHash>
+	TREConditionalMap;
+typedef std::unordered_set<TREEdgeKey, TREEdgeKeyHash> TREEdgeMap;
+// LPub3D Mod End
 
 typedef enum
 {
@@ -291,6 +298,9 @@ public:
 	virtual bool endTexture(void);
 	virtual void finishPart(void);
 	virtual void finishParts(void);
+// LPub3D Mod - parallel part smoothing
+	bool hasPartSubModels(void);
+// LPub3D Mod End
 	virtual void shrinkParts(void);
 
 	TREShapeGroup **getShapes(void) { return m_shapes; }
@@ -313,7 +323,10 @@ protected:
 		TREVertex *points[3];
 	};
 	typedef std::list<TRETriangle> TRETriangleList;
-	typedef std::map<TREVertexKey, TRETriangleList> TRETrianglesMap;
+// LPub3D Mod - hashed vertex keys
+	typedef std::unordered_map<TREVertexKey, TRETriangleList,
+		TREVertexKeyHash> TRETrianglesMap;
+// LPub3D Mod End
 
 	virtual ~TREModel(void);
 	virtual void dealloc(void);
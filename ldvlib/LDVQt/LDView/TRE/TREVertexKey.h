@@ -3,6 +3,10 @@
 
 //#include <TCFoundation/TCVector.h>
 #include <TRE/TREVertexArray.h>
+// LPub3D Mod - hashed vertex keys
+#include <utility>
+#include <stddef.h>
+// LPub3D Mod End
 
 #define TRE_VERTEX_KEY_PRECISION 100.0f
 #define TRE_VERTEX_KEY_ROUNDUP (1.0f / TRE_VERTEX_KEY_PRECISION / 2.0f)
@@ -65,8 +69,45 @@ public:
 		z = other.z;
 		return *this;
 	}
+// LPub3D Mod - hashed vertex keys
+	bool operator==(const TREVertexKey &other) const
+	{
+		return x == other.x && y == other.y && z == other.z;
+	}
+	size_t hash(void) const
+	{
+		size_t value = (size_t)x * 73856093u;
+
+		value ^= (size_t)y * 19349663u;
+		value ^= (size_t)z * 83492791u;
+		return value;
+	}
+// LPub3D Mod End
 private:
 	long x, y, z;
 };
 
+// LPub3D Mod - hashed vertex keys
+// The keys are rounded integer coordinates, so hashed lookups find exactly
+// the same entries as the ordered containers they replace.
+struct TREVertexKeyHash
+{
+	size_t operator()(const TREVertexKey &key) const
+	{
+		return key.hash();
+	}
+};
+
+// Edge with its lesser vertex key first.
+typedef std::pair<TREVertexKey, TREVertexKey> TREEdgeKey;
+
+struct TREEdgeKeyHash
+{
+	size_t operator()(const TREEdgeKey &key) const
+	{
+		return key.first.hash() ^ (key.second.hash() * 31u);
+	}
+};
+// LPub3D Mod End
+
 #endif // __TREVERTEXKEY_H__
@@ -985,6 +985,8 @@ enum ThemeColorType {
 
 #define POVRAY_RENDER_QUALITY_DEFAULT           0    // 0=High, 1-Medium, 2=Low
 #define RENDERER_TIMEOUT_DEFAULT                6    // measured in seconds
+#define LDVIEW_RENDER_WORKERS_DEFAULT           1    // one LDView Single Call process
+#define LDVIEW_RENDER_WORKERS_MAX               4    // maximum concurrent LDView Single Call processes
 
 #define PAGE_CYCLE_DISPLAY_DEFAULT              1    // measured in seconds
 #define PAGE_DISPLAY_PAUSE_DEFAULT              3    // measured in seconds
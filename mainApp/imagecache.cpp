@@ -0,0 +1,393 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 - 2025 Trevor SANDY. All rights reserved.
+**
+** This file may be used under the terms of the
+** GNU General Public Liceense (GPL) version 3.0
+** which accompanies this distribution, and is
+** available at http://www.gnu.org/licenses/gpl.html
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+
+#include "imagecache.h"
+#include "declarations.h"
+#include "lpub.h"
+#include "paths.h"
+#include "lpub_preferences.h"
+#include "rx.h"
+
+// index entries are appended; the index is compacted on load once it
+// holds this many more records than live entries
+#define IMAGE_CACHE_COMPACT_THRESHOLD 1000
+
+QMutex                     ImageCache::mutex;
+QString                    ImageCache::indexFile;
+QHash<QString, QByteArray> ImageCache::imageKeys;
+QHash<QByteArray, QString> ImageCache::keyImages;
+QHash<QString, QByteArray> ImageCache::digests;
+QHash<QString, QPair<QDateTime, QByteArray> > ImageCache::fileDigests;
+QHash<QString, QPair<QString, QByteArray> > ImageCache::pending;
+
+static void addHashLine(QCryptographicHash &hash, const QString &line)
+{
+  hash.addData(line.toUtf8());
+#if QT_VERSION >= QT_VERSION_CHECK(6,4,0)
+  hash.addData(QByteArrayView("\n", 1));
+#else
+  hash.addData("\n", 1);
+#endif
+}
+
+/*
+ * Hash the renderer input. Type 1 lines that reference a submodel also
+ * hash the submodel content so an edit inside a submodel changes the key
+ * of every step that shows it, while unrelated edits do not.
+ * The content is hashed without holding the cache mutex; only the
+ * digest lookups are serialised.
+ */
+
+QByteArray ImageCache::key(const QStringList &parts, const QStringList &parameters)
+{
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+
+  hash.addData(rendererDigest());
+
+  for (const QString &parameter : parameters)
+    addHashLine(hash, parameter);
+
+  QStringList tokens;
+  for (const QString &line : parts) {
+    addHashLine(hash, line);
+    if (line.isEmpty() || line.at(0) != QLatin1Char('1'))
+      continue;
+    split(line, tokens);
+    if (tokens.size() == 15) {
+      QStringList visited;
+      hash.addData(submodelDigest(tokens.at(14), visited));
+    }
+  }
+
+  return hash.result().toHex();
+}
+
+QByteArray ImageCache::submodelDigest(const QString &modelName, QStringList &visited)
+{
+  QString name = modelName.toLower();
+
+  // fade and highlight copies are generated from their parent submodel
+  if (!lpub->ldrawFile.isSubmodel(name)) {
+    const QString extension = QFileInfo(name).suffix();
+    for (const QString &sfx : { QString(FADE_SFX), QString(HIGHLIGHT_SFX) }) {
+      const QString configured = extension.isEmpty() ? sfx + ".ldr" : QString("%1.%2").arg(sfx, extension);
+      if (name.endsWith(configured)) {
+        name.chop(configured.size());
+        name.append(extension.isEmpty() ? QString() : "." + extension);
+        break;
+      }
+    }
+    if (!lpub->ldrawFile.isSubmodel(name))
+      return QByteArray();
+  }
+
+  {
+    QMutexLocker locker(&mutex);
+    if (digests.contains(name))
+      return digests.value(name);
+  }
+
+  if (visited.contains(name))
+    return QByteArray();
+  visited << name;
+
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  QStringList tokens;
+  const QStringList contents = lpub->ldrawFile.contents(name);
+  for (const QString &line : contents) {
+    addHashLine(hash, line);
+    if (line.isEmpty() || line.at(0) != QLatin1Char('1'))
+      continue;
+    split(line, tokens);
+    if (tokens.size() == 15)
+      hash.addData(submodelDigest(tokens.at(14), visited));
+  }
+
+  const QByteArray digest = hash.result();
+
+  QMutexLocker locker(&mutex);
+  digests.insert(name, digest);
+
+  return digest;
+}
+
+/*
+ * Renderer preferences and the ini file of the preferred renderer
+ * change the image without changing the step content.
+ */
+
+QByteArray ImageCache::rendererDigest()
+{
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+
+  addHashLine(hash, QString("%1_%2_%3_%4_%5_%6")
+                            .arg(Preferences::preferredRenderer)
+                            .arg(Preferences::perspectiveProjection)
+                            .arg(Preferences::useNativePovGenerator)
+                            .arg(Preferences::povrayRenderQuality)
+                            .arg(Preferences::povrayAutoCrop)
+                            .arg(Preferences::nativeImageCameraFoVAdjust));
+
+  switch (Preferences::preferredRenderer) {
+  case RENDERER_LDVIEW:
+      hash.addData(fileDigest(Preferences::ldviewIni));
+      break;
+  case RENDERER_LDGLITE:
+      hash.addData(fileDigest(Preferences::ldgliteIni));
+      break;
+  case RENDERER_POVRAY:
+      hash.addData(fileDigest(Preferences::povrayIni));
+      if (!Preferences::useNativePovGenerator)
+          hash.addData(fileDigest(Preferences::ldviewPOVIni));
+      break;
+  default:
+      break;
+  }
+
+  return hash.result();
+}
+
+QByteArray ImageCache::fileDigest(const QString &fileName)
+{
+  if (fileName.isEmpty())
+    return QByteArray();
+
+  const QDateTime modified = QFileInfo(fileName).lastModified();
+
+  {
+    QMutexLocker locker(&mutex);
+    if (fileDigests.contains(fileName) && fileDigests.value(fileName).first == modified)
+      return fileDigests.value(fileName).second;
+  }
+
+  QByteArray digest;
+  QFile file(fileName);
+  if (file.open(QFile::ReadOnly)) {
+    digest = QCryptographicHash::hash(file.readAll(), QCryptographicHash::Sha1);
+    file.close();
+  }
+
+  QMutexLocker locker(&mutex);
+  fileDigests.insert(fileName, qMakePair(modified, digest));
+
+  return digest;
+}
+
+/*
+ * Submodel digests are valid until the model content changes.
+ * Called each time modified content is written to the temp folder.
+ */
+
+void ImageCache::clearDigests()
+{
+  QMutexLocker locker(&mutex);
+
+  digests.clear();
+}
+
+ImageCache::State ImageCache::state(const QString &imageName, const QByteArray &key)
+{
+  QMutexLocker locker(&mutex);
+
+  load();
+
+  const QString name = relativeName(imageName);
+  if (!imageKeys.contains(name))
+    return Unknown;
+
+  return imageKeys.value(name) == key ? Current : Stale;
+}
+
+/*
+ * If another image was rendered from the same key, copy it to imageName
+ * so the step uses the existing render. Returns true when imageName is
+ * available without rendering.
+ */
+
+bool ImageCache::share(const QString &imageName, const QByteArray &key)
+{
+  QMutexLocker locker(&mutex);
+
+  load();
+
+  const QString name = relativeName(imageName);
+  const QString source = keyImages.value(key);
+  if (source.isEmpty() || source == name)
+    return false;
+
+  const QString sourceName = absoluteName(source);
+  if (!QFileInfo::exists(sourceName)) {
+    keyImages.remove(key);
+    return false;
+  }
+
+  if (QFile::exists(imageName))
+    QFile::remove(imageName);
+  if (!QFile::copy(sourceName, imageName)) {
+    emit gui->messageSig(LOG_ERROR, QObject::tr("Could not copy cached image %1 to %2.")
+                                                .arg(sourceName, imageName));
+    return false;
+  }
+
+  imageKeys.insert(name, key);
+  append(name, key);
+
+  return true;
+}
+
+void ImageCache::insert(const QString &imageName, const QByteArray &key)
+{
+  QMutexLocker locker(&mutex);
+
+  load();
+
+  const QString name = relativeName(imageName);
+  imageKeys.insert(name, key);
+  keyImages.insert(key, name);
+  append(name, key);
+}
+
+/*
+ * LDView single call renders a page of CSI images in one batch after
+ * each step is set up. The key is held against the step ldr file and
+ * only recorded once the batch has produced the image.
+ */
+
+void ImageCache::defer(const QString &ldrName, const QString &imageName, const QByteArray &key)
+{
+  QMutexLocker locker(&mutex);
+
+  pending.insert(ldrName, qMakePair(imageName, key));
+}
+
+void ImageCache::commit(const QStringList &ldrNames, bool rendered)
+{
+  QMutexLocker locker(&mutex);
+
+  load();
+
+  for (const QString &ldrName : ldrNames) {
+    if (!pending.contains(ldrName))
+      continue;
+    const QPair<QString, QByteArray> entry = pending.take(ldrName);
+    if (!rendered || !QFileInfo::exists(entry.first))
+      continue;
+    const QString name = relativeName(entry.first);
+    imageKeys.insert(name, entry.second);
+    keyImages.insert(entry.second, name);
+    append(name, entry.second);
+  }
+}
+
+void ImageCache::remove(const QString &imageName)
+{
+  QMutexLocker locker(&mutex);
+
+  load();
+
+  const QString name = relativeName(imageName);
+  if (!imageKeys.contains(name))
+    return;
+
+  const QByteArray key = imageKeys.take(name);
+  if (keyImages.value(key) == name)
+    keyImages.remove(key);
+  append(name, QByteArray());
+}
+
+/*
+ * The index is kept per model working folder. Each record is
+ * 'key<TAB>relative image name'; an empty key removes the image.
+ */
+
+void ImageCache::load()
+{
+  const QString fileName = QDir::toNativeSeparators(QString("%1/%2/imagecache.idx").arg(QDir::currentPath(), Paths::lpubDir));
+  if (fileName == indexFile)
+    return;
+
+  indexFile = fileName;
+  imageKeys.clear();
+  keyImages.clear();
+  digests.clear();
+  pending.clear();
+
+  QFile file(indexFile);
+  if (!file.open(QFile::ReadOnly | QFile::Text))
+    return;
+
+  int records = 0;
+  QTextStream in(&file);
+  while (!in.atEnd()) {
+    const QString line = in.readLine();
+    const int tab = line.indexOf(QLatin1Char('\t'));
+    if (tab < 0)
+      continue;
+    records++;
+    const QByteArray key = line.left(tab).toLatin1();
+    const QString name = line.mid(tab + 1);
+    if (key.isEmpty()) {
+      const QByteArray oldKey = imageKeys.take(name);
+      if (keyImages.value(oldKey) == name)
+        keyImages.remove(oldKey);
+    } else {
+      imageKeys.insert(name, key);
+      if (!keyImages.contains(key) || !QFileInfo::exists(absoluteName(keyImages.value(key))))
+        keyImages.insert(key, name);
+    }
+  }
+  file.close();
+
+  if (records - imageKeys.size() < IMAGE_CACHE_COMPACT_THRESHOLD)
+    return;
+
+  if (!file.open(QFile::WriteOnly | QFile::Truncate | QFile::Text))
+    return;
+
+  QTextStream out(&file);
+  for (QHash<QString, QByteArray>::const_iterator i = imageKeys.constBegin(); i != imageKeys.constEnd(); ++i)
+    if (QFileInfo::exists(absoluteName(i.key())))
+      out << i.value() << '\t' << i.key() << lpub_endl;
+  file.close();
+}
+
+void ImageCache::append(const QString &relativeName, const QByteArray &key)
+{
+  QFile file(indexFile);
+  if (!file.open(QFile::WriteOnly | QFile::Append | QFile::Text)) {
+    emit gui->messageSig(LOG_ERROR, QObject::tr("Cannot open image cache index %1 for writing:<br>%2")
+                                                .arg(indexFile, file.errorString()));
+    return;
+  }
+
+  QTextStream out(&file);
+  out << key << '\t' << relativeName << lpub_endl;
+  file.close();
+}
+
+QString ImageCache::relativeName(const QString &imageName)
+{
+  return QDir::fromNativeSeparators(QDir::current().relativeFilePath(imageName));
+}
+
+QString ImageCache::absoluteName(const QString &relativeName)
+{
+  return QDir::toNativeSeparators(QDir::current().absoluteFilePath(relativeName));
+}
@@ -0,0 +1,73 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 - 2025 Trevor SANDY. All rights reserved.
+**
+** This file may be used under the terms of the
+** GNU General Public Liceense (GPL) version 3.0
+** which accompanies this distribution, and is
+** available at http://www.gnu.org/licenses/gpl.html
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+/*
+ * Content-addressed CSI and PLI image cache.
+ *
+ * An image key is the hash of the part list that feeds the renderer,
+ * the content of every submodel it references, the camera and
+ * renderer parameters, and the renderer preferences and ini settings. Keys are recorded against rendered image files in
+ * an append-only index under the LPub3D working folder so an image is
+ * only re-rendered when something that affects it has changed, and steps
+ * with identical content share one render.
+ */
+
+#ifndef IMAGECACHE_H
+#define IMAGECACHE_H
+
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+
+class ImageCache
+{
+public:
+  enum State
+  {
+    Unknown, // image is not in the index - use the legacy date check
+    Current, // image was rendered from the same key
+    Stale    // image was rendered from a different key
+  };
+
+  static QByteArray key(const QStringList &parts, const QStringList &parameters);
+  static State state(const QString &imageName, const QByteArray &key);
+  static bool share(const QString &imageName, const QByteArray &key);
+  static void insert(const QString &imageName, const QByteArray &key);
+  static void defer(const QString &ldrName, const QString &imageName, const QByteArray &key);
+  static void commit(const QStringList &ldrNames, bool rendered);
+  static void remove(const QString &imageName);
+  static void clearDigests();
+
+private:
+  static void load();
+  static void append(const QString &relativeName, const QByteArray &key);
+  static QString relativeName(const QString &imageName);
+  static QString absoluteName(const QString &relativeName);
+  static QByteArray submodelDigest(const QString &modelName, QStringList &visited);
+  static QByteArray rendererDigest();
+  static QByteArray fileDigest(const QString &fileName);
+
+  static QMutex                      mutex;
+  static QString                     indexFile;
+  static QHash<QString, QByteArray>  imageKeys;   // relative image name -> key
+  static QHash<QByteArray, QString>  keyImages;   // key -> relative image name
+  static QHash<QString, QByteArray>  digests;     // submodel name -> content digest
+  static QHash<QString, QPair<QDateTime, QByteArray> > fileDigests; // renderer ini file -> modified time, content digest
+  static QHash<QString, QPair<QString, QByteArray> > pending; // ldr name -> image name, key awaiting a batch render
+};
+
+#endif // IMAGECACHE_H
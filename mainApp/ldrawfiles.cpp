@@ -36,8 +36,10 @@
 #endif
 
 #include <random>
+#include <cstring>
 
 #include <QMessageBox>
+#include <QCryptographicHash>
 #include <QFile>
 #include <QHash>
 #include <functional>
@@ -79,11 +81,14 @@ const QString LDrawUnofficialType[UNOFFICIAL_NUM] =
  *
  ********************************************/
 
-QList<HiarchLevel*> LDrawFile::_currentLevels;
+thread_local QList<HiarchLevel*> LDrawFile::_currentLevels;
 QList<HiarchLevel*> LDrawFile::_allLevels;
+static QMutex allLevelsMutex;
 
 HiarchLevel* addLevel(const QString& key, bool create)
 {
+    QMutexLocker levelsLocker(&allLevelsMutex);
+
     // if level object with specified key exists...
     const QList _levels = LDrawFile::_allLevels;
     for (HiarchLevel* level : _levels)
@@ -114,6 +119,9 @@ int getLevel(const QString& key, int position)
         // add level object to 'all' levels
         HiarchLevel* level = addLevel(key, true);
 
+        // level objects are shared by the writeToTmp threads
+        QMutexLocker levelsLocker(&allLevelsMutex);
+
         // if there are 'currentLevel' objects...
         if (LDrawFile::_currentLevels.size())
             // set last 'current' level object as parent of this level object
@@ -189,6 +197,8 @@ bool    LDrawFile::_hasUnofficialParts = false;
 bool    LDrawFile::_helperPartsNotInArchive = false;
 bool    LDrawFile::_lsynthPartsNotInArchive = false;
 
+QAtomicInt LDrawSubFile::_lastRevision;
+
 LDrawSubFile::LDrawSubFile(
   const QStringList &contents,
   QDateTime         &datetime,
@@ -218,12 +228,37 @@ LDrawSubFile::LDrawSubFile(
   _includeFile = includeFile;
   _dataFile = dataFile;
   _startPageNumber = 0;
+  nextRevision();
+  setPartTokens();
   _lineTypeIndexes.clear();
   _subFileIndexes.clear();
   _smiContents.clear();
   _prevStepPosition = { 0,0,0 };
 }
 
+/*
+ * Type 1 lines are split once when content is loaded or edited so the
+ * traversal passes do not split the same part lines on every page.
+ * Only lines without surrounding white space are cached, so the tokens
+ * match a split of the line whether or not the caller trimmed it.
+ */
+
+QStringList LDrawSubFile::partTokens(const QString &line)
+{
+  QStringList tokens;
+  if (line.startsWith(QLatin1Char('1')) && !line.at(line.size() - 1).isSpace())
+    split(line, tokens);
+  return tokens;
+}
+
+void LDrawSubFile::setPartTokens()
+{
+  _partTokens.clear();
+  _partTokens.reserve(_contents.size());
+  for (const QString &line : _contents)
+    _partTokens.append(partTokens(line));
+}
+
 /* Only used to store fade or highlight content */
 
 ConfiguredSubFile::ConfiguredSubFile(
@@ -234,6 +269,81 @@ ConfiguredSubFile::ConfiguredSubFile(
     _subFilePath = subFilePath;
 }
 
+/*
+ * Index the lines of an LDraw file in a read-only memory map of the file.
+ * Each line is trimmed in place in the mapping - nothing is copied or
+ * decoded until the line is read. Falls back to reading the file when it
+ * cannot be mapped.
+ */
+
+LDrawFileLines::LDrawFileLines(QFile &file, bool skipEmpty)
+  : _file(file),
+    _mapped(nullptr),
+    _utf8(LDrawFile::_currFileIsUTF8)
+{
+  const qint64 size = file.size();
+  if (size <= 0)
+    return;
+
+  _mapped = file.map(0, size);
+  const char *data = reinterpret_cast<const char *>(_mapped);
+  const char *end  = data + size;
+  if (!_mapped) {
+    _buffer = file.readAll();
+    data    = _buffer.constData();
+    end     = data + _buffer.size();
+  }
+
+  // skip the UTF-8 byte order mark
+  if (end - data >= 3 && !memcmp(data, "\xEF\xBB\xBF", 3))
+    data += 3;
+
+  auto isSpace = [] (const char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+  };
+
+  int lineCount = 0;
+  for (const char *p = data; p < end; p++)
+    if (*p == '\n')
+      lineCount++;
+  _lines.reserve(lineCount + 1);
+
+  const char *next = data;
+  while (next < end) {
+    const char *eol = static_cast<const char *>(memchr(next, '\n', size_t(end - next)));
+    if (!eol)
+      eol = end;
+
+    const char *begin = next, *last = eol;
+    next = eol + 1;
+    if (skipEmpty && (last == begin || (last - begin == 1 && *begin == '\r')))
+      continue;
+
+    while (begin < last && isSpace(*begin))
+      begin++;
+    while (last > begin && isSpace(*(last - 1)))
+      last--;
+
+    _lines.append(qMakePair(begin, int(last - begin)));
+  }
+}
+
+QString LDrawFileLines::at(int i) const
+{
+  const QPair<const char *, int> &line = _lines.at(i);
+  return _utf8 ? QString::fromUtf8(line.first, line.second) : QString::fromLocal8Bit(line.first, line.second);
+}
+
+void LDrawFileLines::clear()
+{
+  _lines.clear();
+  _buffer.clear();
+  if (_mapped) {
+    _file.unmap(_mapped);
+    _mapped = nullptr;
+  }
+}
+
 /* initialize new Build Mod */
 BuildMod::BuildMod(const QVector<int> &modAttributes,
                    int                stepIndex)
@@ -627,6 +737,42 @@ int LDrawFile::getModelStartPageNumber(const QString &mcFileName)
   return 0;
 }
 
+/* return the content revision of each submodel and include file -
+   used to validate the page count summary */
+
+QHash<QString, int> LDrawFile::getSubmodelRevisions()
+{
+  QHash<QString, int> revisions;
+  const QStringList fileNames = QStringList() << _subFileOrder << _includeFileOrder;
+  for (const QString &fileName : fileNames) {
+    QMap<QString, LDrawSubFile>::const_iterator i = _subFiles.constFind(fileName.toLower());
+    if (i != _subFiles.constEnd())
+      revisions.insert(i.key(), i.value()._revision);
+  }
+  return revisions;
+}
+
+/* return a digest of the name and content of each submodel and include
+   file - used to validate the page count saved with the model */
+
+QByteArray LDrawFile::getContentDigest()
+{
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  const QStringList fileNames = QStringList() << _subFileOrder << _includeFileOrder;
+  for (const QString &fileName : fileNames) {
+    QMap<QString, LDrawSubFile>::const_iterator i = _subFiles.constFind(fileName.toLower());
+    if (i == _subFiles.constEnd())
+      continue;
+    hash.addData(i.key().toUtf8());
+    hash.addData("\n", 1);
+    for (const QString &line : i.value()._contents) {
+      hash.addData(line.toUtf8());
+      hash.addData("\n", 1);
+    }
+  }
+  return hash.result();
+}
+
 QDateTime LDrawFile::lastModified(const QString &mcFileName)
 {
   QString fileName = mcFileName.toLower();
@@ -761,6 +907,8 @@ void LDrawFile::setModified(const QString &mcFileName, bool modified)
   if (i != _subFiles.end()) {
     i.value()._modified = modified;
     i.value()._changedSinceLastWrite = modified;
+    if (modified)
+      i.value().nextRevision();
   }
 }
 
@@ -785,6 +933,8 @@ void LDrawFile::setContents(const QString &mcFileName, const QStringList &conten
     i.value()._modified = true;
     //i.value()._datetime = QDateTime::currentDateTime();
     i.value()._contents = contents;
+    i.value().nextRevision();
+    i.value().setPartTokens();
     i.value()._changedSinceLastWrite = true;
   }
 }
@@ -1179,6 +1329,23 @@ QString LDrawFile::readLine(const QString &mcFileName, int lineNumber)
   return QString();
 }
 
+/* return the tokens of line, taken from the part token cache when line is
+   the cached type 1 line at lineNumber */
+
+void LDrawFile::readLineTokens(const QString &mcFileName, int lineNumber, const QString &line, QStringList &tokens)
+{
+  QMap<QString, LDrawSubFile>::const_iterator i = _subFiles.constFind(mcFileName.toLower());
+  if (i != _subFiles.constEnd() && lineNumber >= 0 && lineNumber < i.value()._partTokens.size()) {
+    const QStringList &partTokens = i.value()._partTokens.at(lineNumber);
+    if (partTokens.size() && i.value()._contents.at(lineNumber) == line) {
+      tokens = partTokens;
+      return;
+    }
+  }
+  tokens.clear();
+  split(line, tokens);
+}
+
 void LDrawFile::insertLine(const QString &mcFileName, int lineNumber, const QString &line)
 {
   QString fileName = mcFileName.toLower();
@@ -1188,7 +1355,9 @@ void LDrawFile::insertLine(const QString &mcFileName, int lineNumber, const QStr
     if (lineNumber == i.value()._contents.size()+1)
       lineNumber--;
     i.value()._contents.insert(lineNumber,line);
+    i.value()._partTokens.insert(lineNumber,LDrawSubFile::partTokens(line));
     i.value()._modified = true;
+    i.value().nextRevision();
  //   i.value()._datetime = QDateTime::currentDateTime();
     i.value()._changedSinceLastWrite = true;
   }
@@ -1201,7 +1370,9 @@ void LDrawFile::replaceLine(const QString &mcFileName, int lineNumber, const QSt
 
   if (i != _subFiles.end()) {
     i.value()._contents[lineNumber] = line;
+    i.value()._partTokens[lineNumber] = LDrawSubFile::partTokens(line);
     i.value()._modified = true;
+    i.value().nextRevision();
 //    i.value()._datetime = QDateTime::currentDateTime();
     i.value()._changedSinceLastWrite = true;
   }
@@ -1214,7 +1385,9 @@ void LDrawFile::deleteLine(const QString &mcFileName, int lineNumber)
 
   if (i != _subFiles.end()) {
     i.value()._contents.removeAt(lineNumber);
+    i.value()._partTokens.removeAt(lineNumber);
     i.value()._modified = true;
+    i.value().nextRevision();
 //    i.value()._datetime = QDateTime::currentDateTime();
     i.value()._changedSinceLastWrite = true;
   }
@@ -1417,13 +1590,17 @@ int LDrawFile::instances(const QString &mcFileName, bool mirrored)
 int LDrawFile::loadFile(const QString &fileName)
 {
     QFile file(fileName);
-    if (!file.open(QFile::ReadOnly | QFile::Text)) {
+    if (!file.open(QFile::ReadOnly)) {
         emit gui->messageSig(LOG_ERROR, QObject::tr("Cannot read LDraw file: [%1]<br>%2.")
                              .arg(fileName, file.errorString()));
         return 1;
     }
-    QByteArray qba(file.readAll());
-    file.close();
+    // check the mapped file in place; fall back to a copy when it cannot be mapped
+    const qint64 fileSize = file.size();
+    const uchar *mappedData = fileSize > 0 ? file.map(0, fileSize) : nullptr;
+    QByteArray qba(mappedData ?
+                   QByteArray::fromRawData(reinterpret_cast<const char *>(mappedData), int(fileSize)) :
+                   file.readAll());
 
     QElapsedTimer t; t.start();
 
@@ -1441,6 +1618,9 @@ int LDrawFile::loadFile(const QString &fileName)
     Q_UNUSED(data)
 #endif
 
+    qba.clear();
+    file.close();
+
     // get rid of what's there before we load up new stuff
 
     empty();
@@ -1846,7 +2026,7 @@ void LDrawFile::loadMPDFile(const QString &fileName, bool externalFile)
     QFileInfo   fileInfo(fileName);
 
     QFile file(fileName);
-    if (!file.open(QFile::ReadOnly | QFile::Text)) {
+    if (!file.open(QFile::ReadOnly)) {
         emit gui->messageSig(LOG_ERROR, QObject::tr("Cannot read mpd file %1<br>%2")
                                                     .arg(fileName, file.errorString()));
         return;
@@ -1901,7 +2081,7 @@ void LDrawFile::loadMPDFile(const QString &fileName, bool externalFile)
 
     QByteArray dataFile;
     QString subfileName, subFile, smLine, datafileName;
-    QStringList stagedContents, stagedSubfiles, contents, tokens, searchPaths;
+    QStringList stagedSubfiles, contents, tokens, searchPaths;
     QRegularExpressionMatch match;
 
     if (Preferences::searchLDrawSearchDirs)
@@ -1928,18 +2108,7 @@ void LDrawFile::loadMPDFile(const QString &fileName, bool externalFile)
 
     /* Read it in the first time to put into fileList in order of appearance */
 
-    QTextStream in(&file);
-#if QT_VERSION >= QT_VERSION_CHECK(6,0,0)
-    in.setEncoding(_currFileIsUTF8 ? QStringConverter::Utf8 : QStringConverter::System);
-#else
-    in.setCodec(_currFileIsUTF8 ? QTextCodec::codecForName("UTF-8") : QTextCodec::codecForName("System"));
-#endif
-
-    while ( ! in.atEnd()) {
-        QString smLine = in.readLine(0);
-        stagedContents << smLine.trimmed();
-    }
-    file.close();
+    LDrawFileLines stagedContents(file);
 
     int lineCount = stagedContents.size();
 
@@ -1958,17 +2127,18 @@ void LDrawFile::loadMPDFile(const QString &fileName, bool externalFile)
 
     for (lineIndx = 0; lineIndx < lineCount; lineIndx++) {
 
-        smLine = stagedContents.at(lineIndx).trimmed();
-
         emit gui->progressBarPermSetValueSig(lineIndx);
 
-        if (smLine.isEmpty())
+        const QLatin1String smView = stagedContents.view(lineIndx);
+        if (smView.isEmpty())
             continue;
-        else if (smLine == "0") {
-            contents << smLine;
+        else if (smView == QLatin1String("0")) {
+            contents << QString(smView);
             continue;
         }
 
+        smLine = stagedContents.at(lineIndx);
+
         sof = smLine.contains(_fileRegExp[SOF_RX]);  //start of submodel file
         if (!topFileNotFound && sof && !eof && !eosf && !eoef && !externalFile)
             endStepMetaMissing = true;
@@ -1978,11 +2148,12 @@ void LDrawFile::loadMPDFile(const QString &fileName, bool externalFile)
 
         if (externalFile) {
             if (!loadingExternalFile && !((lineIndx + 1) >= lineCount)) {
-                if ((soef = stagedContents.at(lineIndx + 1).trimmed().contains(_fileRegExp[NAM_RX]))) {
-                    for (QString &line : stagedContents) {
-                        if (!line.isEmpty() && !line.startsWith("0 "))
+                if ((soef = stagedContents.at(lineIndx + 1).contains(_fileRegExp[NAM_RX]))) {
+                    for (int i = 0; i < lineCount; i++) {
+                        const QLatin1String line = stagedContents.view(i);
+                        if (!line.isEmpty() && !line.startsWith(QLatin1String("0 ")))
                             break;
-                        if (getUnofficialFileType(line) > UNOFFICIAL_SUBMODEL) // external file is a part so exit
+                        if (getUnofficialFileType(stagedContents.at(i)) > UNOFFICIAL_SUBMODEL) // external file is a part so exit
                             return;
                     }
                     hdrDescLine = lineIndx;
@@ -2581,7 +2752,7 @@ void LDrawFile::loadLDRFile(const QString &filePath, const QString &fileName, bo
         _subFiles.remove(fileInfo.fileName());
 
         QFile file(fullName);
-        if ( ! file.open(QFile::ReadOnly | QFile::Text)) {
+        if ( ! file.open(QFile::ReadOnly)) {
             emit gui->messageSig(LOG_ERROR,QObject::tr("Cannot read ldr file %1<br>%2")
                                                        .arg(fullName, file.errorString()));
             return;
@@ -2626,7 +2797,7 @@ void LDrawFile::loadLDRFile(const QString &filePath, const QString &fileName, bo
         unofficialPart = UNOFFICIAL_UNKNOWN;
 
         QString subfileName, subFile, smLine;
-        QStringList stagedContents, stagedSubfiles, contents, tokens, searchPaths;
+        QStringList stagedSubfiles, contents, tokens, searchPaths;
         QRegularExpressionMatch match;
 
         if (Preferences::searchLDrawSearchDirs)
@@ -2653,31 +2824,28 @@ void LDrawFile::loadLDRFile(const QString &filePath, const QString &fileName, bo
 
         /* Read it in the first time to put into fileList in order of appearance */
 
-        QTextStream in(&file);
-#if QT_VERSION >= QT_VERSION_CHECK(6,0,0)
-        in.setEncoding(_currFileIsUTF8 ? QStringConverter::Utf8 : QStringConverter::System);
-#else
-        in.setCodec(_currFileIsUTF8 ? QTextCodec::codecForName("UTF-8") : QTextCodec::codecForName("System"));
-#endif
-        bool checked = false;
-        while ( ! in.atEnd()) {
-            smLine = in.readLine(0);
-            if (!smLine.isEmpty())
-                stagedContents << smLine.trimmed();
-            if (!checked) {
-                checked = (smLine.contains(_fileRegExp[LDR_RX]) || smLine.contains(_fileRegExp[NAM_RX]));
-                if (smLine.contains(_fileRegExp[SOF_RX])) {
-                    file.close();
-                    stagedContents.clear();
-                    const QString fileTypeUpper = fileType();
-                    const QString scModelType = fileTypeUpper[0].toUpper() + fileType().right(fileType().size() - 1);
-                    emit gui->messageSig(LOG_INFO_STATUS, QObject::tr("%1 file %2 identified as Multi-Part LDraw System (MPD) Document").arg(scModelType, fileInfo.fileName()));
-                    loadMPDFile(fileInfo.absoluteFilePath());
-                    return;
-                }
-            }
+        LDrawFileLines stagedContents(file, true/*skipEmpty*/);
+
+        bool mpdFile = false;
+        for (int i = 0; i < stagedContents.size(); i++) {
+            const QLatin1String view = stagedContents.view(i);
+            if (!view.startsWith(QLatin1Char('0')) && !view.startsWith(QLatin1Char('1')))
+                continue;
+            const QString line = stagedContents.at(i);
+            if ((mpdFile = line.contains(_fileRegExp[SOF_RX])))
+                break;
+            if (line.contains(_fileRegExp[LDR_RX]) || line.contains(_fileRegExp[NAM_RX]))
+                break;
+        }
+        if (mpdFile) {
+            stagedContents.clear();
+            file.close();
+            const QString fileTypeUpper = fileType();
+            const QString scModelType = fileTypeUpper[0].toUpper() + fileType().right(fileType().size() - 1);
+            emit gui->messageSig(LOG_INFO_STATUS, QObject::tr("%1 file %2 identified as Multi-Part LDraw System (MPD) Document").arg(scModelType, fileInfo.fileName()));
+            loadMPDFile(fileInfo.absoluteFilePath());
+            return;
         }
-        file.close();
 
         int lineCount = stagedContents.size();
 
@@ -2698,13 +2866,13 @@ void LDrawFile::loadLDRFile(const QString &filePath, const QString &fileName, bo
 
         for (lineIndx = 0; lineIndx < lineCount; lineIndx++) {
 
-            smLine = stagedContents.at(lineIndx).trimmed();
-
             emit gui->progressBarPermSetValueSig(lineIndx);
 
-            if (smLine.isEmpty())
+            if (stagedContents.view(lineIndx).isEmpty())
                 continue;
 
+            smLine = stagedContents.at(lineIndx);
+
             if (subfileName.isEmpty() && !hdrNameKey && hdrNameNotFound && (topLevelModel || !smLine.isEmpty())) {
                 sosf = smLine.contains(_fileRegExp[NAM_RX]);
             } else if (!hdrNameNotFound && smLine.startsWith("0")) {
@@ -4735,6 +4903,7 @@ bool LDrawFile::deleteBuildMod(const QString &buildModKey)
           if (s.value()._buildMods > 0)
             s.value()._buildMods -= 1;
           s.value()._modified = true;
+          s.value().nextRevision();
           s.value()._changedSinceLastWrite = true;
         }
 
@@ -5161,6 +5330,7 @@ void LDrawFile::clearBuildModAction(const QString &buildModKey,const int stepInd
             if (s != _subFiles.end()) {
               s.value()._modified = true;
               s.value()._changedSinceLastWrite = true;
+              s.value().nextRevision();
 #ifdef QT_DEBUG_MODE
               change = true;
 #endif
@@ -6496,8 +6666,7 @@ bool isHeader(const QString &line)
 }
 
 bool isComment(const QString &line) {
-  static QRegularExpression commentLine;
-  commentLine.setPattern("^\\s*0\\s+\\/\\/\\s*.*$");
+  static const QRegularExpression commentLine("^\\s*0\\s+\\/\\/\\s*.*$");
   if (line.contains(commentLine))
     return true;
   return false;
@@ -6522,10 +6691,9 @@ QString joinLine(const QStringList &argv)
  */
 bool isSubstitute(const QString &line, QString &lineOut)
 {
-  static QRegularExpression substitutePartRx;
+  static const QRegularExpression substitutePartRx("\\sBEGIN\\sSUB\\s(.*(?:\\.dat|\\.ldr)|[^.]{5})",
+                                                  QRegularExpression::CaseInsensitiveOption);
   QRegularExpressionMatch match;
-  substitutePartRx.setPattern("\\sBEGIN\\sSUB\\s(.*(?:\\.dat|\\.ldr)|[^.]{5})");
-  substitutePartRx.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
   match = substitutePartRx.match(line);
   if (match.hasMatch()) {
     lineOut = match.captured(1);
@@ -6542,9 +6710,8 @@ bool isSubstitute(const QString &line)
 
 bool isGhost(const QString &line)
 {
-  static QRegularExpression ghostMeta;
+  static const QRegularExpression ghostMeta("^\\s*0\\s+GHOST\\s+.*$");
   QRegularExpressionMatch match;
-  ghostMeta.setPattern("^\\s*0\\s+GHOST\\s+.*$");
   match = ghostMeta.match(line);
   if (match.hasMatch())
     return true;
@@ -37,12 +37,17 @@
 #include <QMultiMap>
 #include <QList>
 #include <QMutex>
+#include <QAtomicInt>
+#include <QHash>
 #include <QDateTime>
 #include <QFuture>
+#include <QFile>
 
 #include "excludedparts.h"
 #include "lpub_qtcompat.h"
 
+class QFile;
+
 extern QList<QRegularExpression> LDrawHeaderRegExp;
 extern QList<QRegularExpression> LDrawUnofficialPartRegExp;
 extern QList<QRegularExpression> LDrawUnofficialSubPartRegExp;
@@ -222,6 +227,7 @@ public:
     QVector<int> _lineTypeIndexes;
     QVector<int> _prevStepPosition;
     QVector<int> _subFileIndexes;
+    QVector<QStringList> _partTokens; // type 1 line tokens - empty for other lines
     int          _numSteps;
     int          _buildMods;
     bool         _beenCounted;
@@ -236,11 +242,15 @@ public:
     bool         _displayModel;
     int          _startPageNumber;
     int          _unofficialPart;
+    int          _revision;      // content revision - changes on every edit, used to validate the page count summary
+
+    static QAtomicInt _lastRevision;
 
     LDrawSubFile()
     {
       _unofficialPart = 0;
       _prevStepPosition = { 0,0,0 };
+      nextRevision();
     }
     LDrawSubFile(
         const QStringList &contents,
@@ -252,18 +262,59 @@ public:
         bool               dataFile = false,
         const QString     &subFilePath = QString(),
         const QString     &description = QString());
+    void nextRevision()
+    {
+      _revision = _lastRevision.fetchAndAddOrdered(1) + 1;
+    }
+    void setPartTokens();
+    static QStringList partTokens(const QString &line);
     ~LDrawSubFile()
     {
       _contents.clear();
       _smiContents.clear();
       _lineTypeIndexes.clear();
       _subFileIndexes.clear();
+      _partTokens.clear();
       _prevStepPosition.clear();
       _renderedKeys.clear();
       _mirrorRenderedKeys.clear();
     }
 };
 
+/*
+ * The lines of an LDraw file read from a read-only memory map of the file.
+ * Each line is kept as a trimmed byte range into the mapping and is only
+ * decoded into a QString when at() is called. The file must stay open
+ * while the lines are used.
+ */
+class LDrawFileLines
+{
+public:
+    LDrawFileLines(QFile &file, bool skipEmpty = false);
+    ~LDrawFileLines()
+    {
+      clear();
+    }
+    int size() const
+    {
+      return _lines.size();
+    }
+    QLatin1String view(int i) const
+    {
+      return QLatin1String(_lines.at(i).first, _lines.at(i).second);
+    }
+    QString at(int i) const;
+    void clear();
+
+private:
+    Q_DISABLE_COPY(LDrawFileLines)
+    QFile     &_file;
+    uchar     *_mapped;
+    QByteArray _buffer;
+    bool       _utf8;
+    QVector<QPair<const char *, int> > _lines;
+};
+
 class LDrawFile {
   private:
     QMap<QString, LDrawSubFile> _subFiles;
@@ -355,7 +406,7 @@ class LDrawFile {
     static QStringList               _subFileOrderNoUnoff;
     static QStringList               _displayModelList;
     static QStringList               _buildModList;
-    static QList<HiarchLevel*>       _currentLevels;
+    static thread_local QList<HiarchLevel*> _currentLevels; // per thread - concurrent writeToTmp
     static QList<HiarchLevel*>       _allLevels;
     static QStringList               _loadedItems;
     static QStringList               _processedSubfiles;
@@ -449,6 +500,8 @@ class LDrawFile {
     void setModelStartPageNumber(const QString &mcFileName,
                                  const int &startPageNumber);
     int getModelStartPageNumber(const QString &mcFileName);
+    QHash<QString, int> getSubmodelRevisions();
+    QByteArray getContentDigest();
     void subFileLevels(QStringList &contents, int &level);
     int loadFile(const QString &fileName);
     void loadMPDFile(const QString &fileName,
@@ -464,6 +517,7 @@ class LDrawFile {
     
     QString fileType(int isUnofficial = 0);
     QString readLine(const QString &fileName, int lineNumber);
+    void readLineTokens(const QString &fileName, int lineNumber, const QString &line, QStringList &tokens);
     void insertLine( const QString &fileName, int lineNumber, const QString &line);
     void replaceLine(const QString &fileName, int lineNumber, const QString &line);
     void deleteLine( const QString &fileName, int lineNumber);
@@ -45,6 +45,7 @@
 #include "editwindow.h"
 #include "parmswindow.h"
 #include "paths.h"
+#include "imagecache.h"
 #include "globals.h"
 #include "resolution.h"
 #include "lpub_object.h"
@@ -150,6 +151,10 @@ QString      Gui::curSubFile;             // whats being displayed in the edit w
 QString      Gui::saveFileName;           // user specified output file Name [commandline only]
 QString      Gui::pageRangeText;          // page range parameters
 QList<Where> Gui::topOfPages;             // topOfStep list of modelName and lineNumber for each page
+QList<PageCountSpan> Gui::pageCountSpans; // submodel instances walked by the running page count
+QHash<QString, int> Gui::pageCountSpanIndexes; // first span of each submodel walked by the running page count
+bool         Gui::pageCountRecording;     // record pageCountSpans for the running page count
+QList<PageCountRendered> Gui::pageCountRendered; // submodel instances marked rendered by the running page count
 QList<Where> Gui::parsedMessages;         // previously parsed messages within the current session
 QStringList  Gui::messageList;            // message list used when exporting or continuous processing
 QStringList  Gui::bomParts;               // list of part strings configured for BOM setup
@@ -2370,6 +2375,7 @@ void Gui::clearStepCSICache(QString &pngName) {
     QString ldrName      = tmpDirName + QDir::separator() + QLatin1String("csi.ldr");
     QFileInfo fileInfo(pngName);
     QFile file(assemDirName + QDir::separator() + fileInfo.fileName());
+    ImageCache::remove(file.fileName());
     if (file.exists()) {
         if (!file.remove())
             emit gui->messageSig(LOG_ERROR,tr("Unable to remove %1")
@@ -3400,6 +3406,7 @@ Gui::Gui()
     mRotStepAngleZ                  = 0.0f;
     mRotStepType                    = QString();
     mPliIconsPath.clear();
+    pageCountWatched                = false;
 
     selectedItemObj                 = UndefinedObj;
     mViewerZoomLevel                = 50;
@@ -3603,6 +3610,9 @@ Gui::Gui()
     connect(this,           SIGNAL(setExportingSig(bool)),
             this,             SLOT(   setExporting(bool)));
 
+    connect(this,           SIGNAL(setExportingSig(bool)),
+            lpub,             SLOT(   SetNativeRenderSession(bool)));
+
     connect(this,           SIGNAL(setExportingObjectsSig(bool)),
             this,             SLOT(   setExportingObjects(bool)));
 
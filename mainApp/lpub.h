@@ -343,6 +343,7 @@
 #include <QFile>
 #include <QProgressBar>
 #include <QElapsedTimer>
+#include <QSharedPointer>
 #include <QPdfWriter>
 
 #include "lpub_qtcompat.h"
@@ -458,6 +459,123 @@ class Range;
 class Steps;
 class Where;
 
+/*
+ * One submodel instance walked by a complete page count - the state the
+ * parent handed to the submodel walk and the pages the walk produced.
+ * A changed leaf submodel is counted again from its span and the pages
+ * after the span are shifted instead of walking the whole model.
+ */
+class PageCountSpan
+{
+public:
+  Where                current;          // submodel start line
+  QString              addLine;          // parent type 1 line of the instance
+  QSharedPointer<Meta> meta;             // meta at submodel entry - released when the span holds nested spans
+  FindPageFlags        flags;
+  bool                 pageDisplayed;
+  bool                 displayModel;
+  bool                 updateViewer;
+  bool                 isMirrored;
+  bool                 printing;
+  int                  stepNumber;
+  int                  contStepNumber;
+  int                  groupStepNumber;
+  QString              renderModelColour;
+  QString              renderParentModel;
+  int                  startPage;        // page number at submodel entry
+  int                  endPage;          // page number at submodel exit
+  int                  startTopOfPages;  // topOfPages size at submodel entry
+  int                  endTopOfPages;    // topOfPages size at submodel exit
+  int                  firstStepPageNum; // firstStepPageNum at submodel entry
+  int                  lastStepPageNum;  // lastStepPageNum at submodel entry
+  int                  exitFirstStepPageNum;
+  int                  exitLastStepPageNum;
+  int                  exitCountInstance;// meta settings a submodel can leave to its parent walk
+  int                  exitCalloutBegin;
+  bool                 exitParseNoStep;
+  bool                 nested;           // the walk entered other submodels
+
+  PageCountSpan()
+    : pageDisplayed(false),
+      displayModel(false),
+      updateViewer(false),
+      isMirrored(false),
+      printing(false),
+      stepNumber(0),
+      contStepNumber(0),
+      groupStepNumber(0),
+      startPage(0),
+      endPage(0),
+      startTopOfPages(0),
+      endTopOfPages(0),
+      firstStepPageNum(-1),
+      lastStepPageNum(-1),
+      exitFirstStepPageNum(-1),
+      exitLastStepPageNum(-1),
+      exitCountInstance(0),
+      exitCalloutBegin(0),
+      exitParseNoStep(false),
+      nested(false)
+  {}
+};
+
+/*
+ * A submodel instance the page count walk marks as rendered. Restoring
+ * a page count marks the same instances.
+ */
+class PageCountRendered
+{
+public:
+  QString              modelName;
+  QString              modelColour;
+  QString              renderParentModel;
+  bool                 mirrored;
+  int                  stepNumber;
+  int                  countInstance;
+
+  PageCountRendered()
+    : mirrored(false),
+      stepNumber(0),
+      countInstance(0)
+  {}
+};
+
+/*
+ * Registers set by the last complete page count and the submodel
+ * content revisions it was counted from. A page count that finds the
+ * same revisions restores these registers instead of walking the model.
+ */
+class PageCountSummary
+{
+public:
+  QHash<QString, int> revisions;        // submodel name -> content revision
+  QHash<QString, int> startPageNumbers; // submodel name -> model start page number
+  QList<PageCountSpan> spans;           // submodel instances in walk order
+  QList<PageCountRendered> rendered;    // submodel instances marked rendered by the count walk
+  QString             fileName;         // model file the summary was counted or loaded for
+  QList<Where>        topOfPages;
+  Where               current;
+  int                 maxPages;
+  int                 stepPageNum;
+  int                 firstStepPageNum;
+  int                 lastStepPageNum;
+  int                 pa;
+  int                 sa;
+  bool                buildModEnabled;
+  bool                valid;
+
+  PageCountSummary()
+    : maxPages(0),
+      stepPageNum(0),
+      firstStepPageNum(-1),
+      lastStepPageNum(-1),
+      pa(0),
+      sa(0),
+      buildModEnabled(false),
+      valid(false)
+  {}
+};
+
 class Gui : public QMainWindow
 {
 
@@ -490,6 +608,10 @@ public:
   static QString  saveFileName;         // user specified output file Name [commandline only]
 
   static QList<Where> topOfPages;       // topOfStep list of modelName and lineNumber for each page
+  static QList<PageCountSpan> pageCountSpans; // submodel instances walked by the running page count
+  static QHash<QString, int> pageCountSpanIndexes; // first span of each submodel walked by the running page count
+  static bool     pageCountRecording;   // record pageCountSpans for the running page count
+  static QList<PageCountRendered> pageCountRendered; // submodel instances marked rendered by the running page count
 
   static RendererData savedRendererData;// store current renderer data when temporarily switching renderer;
   static int          saveRenderer;     // saved renderer when temporarily switching to Native renderer
@@ -1114,7 +1236,6 @@ public:
     return false; // Preferences::preferredRenderer == RENDERER_NATIVE;
   }
 
-  void writeSmiContent(QStringList *content, const QString &fileName);
   QStringList getModelFileContent(QStringList *content, const QString &fileName);
   bool installRenderer(const int which);
 
@@ -1130,7 +1251,7 @@ public:
   static void scanPast(    Where &here, const QRegularExpression &lineRx);
   static bool stepContains(Where &here, const QString &value);
   static bool stepContains(Where &here, const QRegularExpression &lineRx, QString &result, int capGrp = 0, bool displayModel = false);
-  static bool stepContains(Where &here, QRegularExpression &lineRx, bool displayModel = false);
+  static bool stepContains(Where &here, const QRegularExpression &lineRx, bool displayModel = false);
 
   static QString elapsedTime(const qint64 &duration, bool pretty = true);
 
@@ -1499,6 +1620,14 @@ public slots:
   void deleteFinalModelStep(bool force = false);
 
   void countPages();
+  static int openPageCountSpan(Meta *meta, FindPageOptions &opts, const QString &addLine);
+  static void closePageCountSpan(int index, Meta *meta, int pageNum);
+  static void addPageCountRendered(FindPageOptions &opts);
+  void savePageCount();
+  bool restorePageCount();
+  bool recountPageCount(const QStringList &changed);
+  bool readPageCount();
+  void writePageCount();
   void pageSetup();
   void assemSetup();
   void pliSetup();
@@ -1679,6 +1808,9 @@ protected:
   QMap<QString, QString> mPliIconsPath;        // used to set an icon image in the Visual Editor timeline view
   QVector<int>           mBuildModRange;       // begin and end range of modified parts from Visual Editor
   QFutureWatcher<int>    futureWatcher;        // watch the countPage future
+  bool                   pageCountWatched;     // futureWatcher is watching a countPage future started by drawPage
+  QHash<QString, int>    pageCountRevisions;   // submodel content revisions when the running page count started
+  PageCountSummary       pageCountSummary;     // registers from the last complete page count
 
   int                    mViewerZoomLevel;
 
@@ -1709,7 +1841,9 @@ private:
 #else
     QMutex               pageMutex;          // recursive drawPage, buildModNextStep, and findPage mutex,
 #endif
-  QMutex                 writeMutex;         // non-recursive write to temp working directory and countPage mutex 
+  QMutex                 writeMutex;         // non-recursive guard for the per-file write to temp working directory mutexes
+  QHash<QString, QSharedPointer<QMutex> > writeFileMutexes; // per-file write to temp working directory mutexes
+  QMutex                 writeBuildModMutex; // non-recursive guard for BuildMod lookups made by concurrent writeToTmp parses
 
   QTimer                 updateTimer;        // keep UI responsive when exporting or using continuous page processing
 
@@ -1835,7 +1969,9 @@ private:
 
   void writeToTmp();
 
-  QStringList writeToTmp(const QString &fileName, const QStringList &, bool = true);
+  QStringList writeToTmp(const QString &fileName, const QStringList &, bool = true, QHash<int, QVector<int> > * = nullptr);
+
+  QSharedPointer<QMutex> writeFileMutex(const QString &fileName);
 
   void attitudeAdjustment(); // reformat the LDraw file to fix LPub backward compatibility issues
 
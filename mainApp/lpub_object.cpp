@@ -390,8 +390,17 @@ bool LPub::OpenProject(const NativeOptions* Options, int Type/*NATIVE_VIEW*/, bo
 
     if (Type != NATIVE_VIEW) // NATIVE_IMAGE or NATIVE_EXPORT
     {
+        // During a native render session the image project is kept and reloaded for each image
+        bool ReuseLoader = false;
+
         if (Type == NATIVE_IMAGE)
-            Loader = new Project(false/*IsPreview*/, NATIVE_IMAGE);
+        {
+            Project* ActiveProject = IsNativeRenderSession() ? lcGetActiveProject() : nullptr;
+            if ((ReuseLoader = ActiveProject && ActiveProject->IsRenderImage()))
+                Loader = ActiveProject;
+            else
+                Loader = new Project(false/*IsPreview*/, NATIVE_IMAGE);
+        }
         else
             Loader = new Project();
 
@@ -399,6 +408,8 @@ bool LPub::OpenProject(const NativeOptions* Options, int Type/*NATIVE_VIEW*/, bo
             Loader->SetLPubFadeHighlightParts(
                 Options->FadeParts,
                 Options->HighlightParts);
+        else if (ReuseLoader)
+            Loader->SetLPubFadeHighlightParts(false, false);
 
         QString FileName, StepKey;
         if (UseFile && !Options->InputFileName.isEmpty())
@@ -406,14 +417,25 @@ bool LPub::OpenProject(const NativeOptions* Options, int Type/*NATIVE_VIEW*/, bo
         else
            StepKey = Options->ViewerStepKey;
 
-        Loaded = Loader->Load(FileName, StepKey, Options->ImageType, false/*ShowErrors*/);
+        const QByteArray FileData = Type == NATIVE_IMAGE ? TakeNativeRenderContent(FileName) : QByteArray();
+
+        if (FileData.isEmpty())
+            Loaded = Loader->Load(FileName, StepKey, Options->ImageType, false/*ShowErrors*/);
+        else
+            Loaded = Loader->Load(FileName, FileData, Options->ImageType);
 
         if (Loaded)
         {
-            gApplication->SetProject(Loader);
+            if (ReuseLoader)
+            {
+                Loader->SetActiveModel(0, true);
+                lcGetPiecesLibrary()->RemoveTemporaryPieces();
+            }
+            else
+                gApplication->SetProject(Loader);
             lcView::UpdateProjectViews(Loader);
         }
-        else
+        else if (!ReuseLoader)
             delete Loader;
     }
     else if (gMainWindow) // NATIVE_VIEW
@@ -468,6 +490,59 @@ bool LPub::OpenProject(const NativeOptions* Options, int Type/*NATIVE_VIEW*/, bo
     return Loaded;
 }
 
+/********************************************************************
+ *  Native render session
+ *
+ *  While images are exported with the native renderer, the image
+ *  project and the offscreen framebuffer are kept between images, and
+ *  the rotated step content is handed over in memory instead of being
+ *  read back from the ldr file.
+ * *****************************************************************/
+
+void LPub::SetNativeRenderSession(bool Active)
+{
+    Active &= Preferences::preferredRenderer == RENDERER_NATIVE;
+
+    if (Active == IsNativeRenderSession())
+        return;
+
+    mNativeRenderSession.storeRelease(Active ? 1 : 0);
+
+    lcView::SetKeepRenderFramebuffer(Active);
+
+    if (!Active)
+    {
+        QMutexLocker Locker(&mNativeRenderContentMutex);
+        mNativeRenderContent.clear();
+    }
+}
+
+void LPub::SetNativeRenderContent(const QString &FileName, const QStringList &Content)
+{
+    if (!IsNativeRenderSession() || FileName.isEmpty())
+        return;
+
+    // empty content drops what was held for a file rewritten for another renderer
+    QByteArray FileData;
+    for (const QString &Line : Content)
+        FileData.append(Line.toUtf8()).append('\n');
+
+    QMutexLocker Locker(&mNativeRenderContentMutex);
+    if (FileData.isEmpty())
+        mNativeRenderContent.remove(QDir::toNativeSeparators(FileName));
+    else
+        mNativeRenderContent.insert(QDir::toNativeSeparators(FileName), FileData);
+}
+
+QByteArray LPub::TakeNativeRenderContent(const QString &FileName)
+{
+    if (!IsNativeRenderSession() || FileName.isEmpty())
+        return QByteArray();
+
+    QMutexLocker Locker(&mNativeRenderContentMutex);
+    return mNativeRenderContent.take(QDir::toNativeSeparators(FileName));
+}
+
 /********************************************************************
  *  Visual Editor viewpoint latitude longitude
  * *****************************************************************/
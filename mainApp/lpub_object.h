@@ -16,6 +16,9 @@
 #define LPUB_OBJECT_H
 
 #include <QObject>
+#include <QHash>
+#include <QMutex>
+#include <QAtomicInt>
 #include <QStringList>
 
 #include "declarations.h"
@@ -58,6 +61,13 @@ public:
   /// Open project to enable native visual editor or image render
   bool OpenProject(const NativeOptions*, int = NATIVE_VIEW, bool = false);
 
+  /// Native render session - image content held in memory during an export
+  bool IsNativeRenderSession() const
+  {
+    return mNativeRenderSession.loadAcquire() != 0;
+  }
+  void SetNativeRenderContent(const QString &FileName, const QStringList &Content);
+
   /// Visual Editor viewpoint latitude longitude
   int SetViewpointLatLonDialog(bool SetCamera = false);
 
@@ -249,6 +259,9 @@ public slots:
   /// Visual editor transform
   void saveVisualEditorTransformSettings();
 
+  /// Native render session
+  void SetNativeRenderSession(bool);
+
   /// Download management public slots
   void httpDownloadFinished();
   void cancelDownload();
@@ -312,8 +325,15 @@ protected:
   Rc                     mUpdateLDViewIni = OkRc;
 
 private:
+  QByteArray TakeNativeRenderContent(const QString &FileName);
+
   bool                   mFileLoaded = false;
   bool                   mFileLoadFail = false;
+
+  /// Native render session
+  QAtomicInt             mNativeRenderSession;
+  QMutex                 mNativeRenderContentMutex;
+  QHash<QString, QByteArray> mNativeRenderContent;
   static QString         commandlineFile;
 };
 
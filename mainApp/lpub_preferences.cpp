@@ -591,6 +591,7 @@ int     Preferences::gridSizeIndex              = GRID_SIZE_INDEX_DEFAULT;
 int     Preferences::pageHeight                 = PAGE_HEIGHT_DEFAULT;
 int     Preferences::pageWidth                  = PAGE_WIDTH_DEFAULT;
 int     Preferences::rendererTimeout            = RENDERER_TIMEOUT_DEFAULT;          // measured in seconds
+int     Preferences::ldviewRenderWorkers        = LDVIEW_RENDER_WORKERS_DEFAULT;     // concurrent LDView Single Call processes
 int     Preferences::pageDisplayPause           = PAGE_DISPLAY_PAUSE_DEFAULT;        // measured in seconds
 int     Preferences::nativeImageCameraFoVAdjust = NATIVE_IMAGE_CAMERA_FOV_ADJUST;
 int     Preferences::msgBoxMinimumWidth         = DEFAULT_MSG_BOX_MIN_WIDTH;
@@ -1178,7 +1179,7 @@ void Preferences::loggingPreferences()
         logger.setColorizeOutput(      true);
 
         // Create log destinations
-        DestinationPtr fileDestination(DestinationFactory::MakeFileDestination(logFilePath, EnableLogRotation, MaxSizeBytes(5000000), MaxOldLogCount(5)));
+        DestinationPtr fileDestination(DestinationFactory::MakeAsyncFileDestination(logFilePath, EnableLogRotation, MaxSizeBytes(5000000), MaxOldLogCount(5)));
         DestinationPtr debugDestination(DestinationFactory::MakeDebugOutputDestination());
 
         // set log destinations on the logger
@@ -2895,6 +2896,14 @@ void Preferences::rendererPreferences()
         rendererTimeout = Settings.value(QString("%1/%2").arg(SETTINGS,"RendererTimeout")).toInt();
     }
 
+    // LDView Single Call worker processes
+    if ( ! Settings.contains(QString("%1/%2").arg(SETTINGS,"LDViewRenderWorkers"))) {
+        ldviewRenderWorkers = LDVIEW_RENDER_WORKERS_DEFAULT;
+        Settings.setValue(QString("%1/%2").arg(SETTINGS,"LDViewRenderWorkers"),ldviewRenderWorkers);
+    } else {
+        ldviewRenderWorkers = qBound(1, Settings.value(QString("%1/%2").arg(SETTINGS,"LDViewRenderWorkers")).toInt(), LDVIEW_RENDER_WORKERS_MAX);
+    }
+
     // Write config files
     logInfo() << qUtf8Printable(QObject::tr("Processing renderer configuration files..."));
 
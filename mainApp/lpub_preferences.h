@@ -452,6 +452,7 @@ class Preferences
     static int     gridSizeIndex;
     static int     pageDisplayPause;
     static int     rendererTimeout;
+    static int     ldviewRenderWorkers;
     static int     sceneGuidesLine;
     static int     sceneGuidesPosition;
     static int     povrayRenderQuality;
@@ -489,6 +489,7 @@ HEADERS += \
     csiitem.h \
     declarations.h \
     dependencies.h \
+    imagecache.h \
     dialogexportpages.h \
     dividerdialog.h \
     dividerpointeritem.h \
@@ -611,6 +612,7 @@ SOURCES += \
     csiannotation.cpp \
     csiitem.cpp \
     dependencies.cpp \
+    imagecache.cpp \
     dialogexportpages.cpp \
     dividerdialog.cpp \
     dividerpointeritem.cpp \
@@ -53,7 +53,6 @@ QHash<QString, int> tokenMap;
 QHash<Rc, QRegularExpression> groupRegExMap;
 
 bool AbstractMeta::reportErrors = false;
-QRegularExpression AbstractMeta::rx;
 
 void AbstractMeta::init(BranchMeta *parent, QString name)
 {
@@ -95,6 +94,21 @@ BranchMeta::~BranchMeta()
   list.clear();
 }
 
+/*
+ * Branch keywords are also regular expressions. Each is compiled once and shared,
+ * meta commands are parsed on several threads while writeToTmp runs.
+ */
+static QRegularExpression branchKeywordRx(const QString &keyword)
+{
+  static QMutex keywordRxMutex;
+  static QHash<QString, QRegularExpression> keywordRxs;
+  QMutexLocker locker(&keywordRxMutex);
+  QHash<QString, QRegularExpression>::iterator it = keywordRxs.find(keyword);
+  if (it == keywordRxs.end())
+    it = keywordRxs.insert(keyword, QRegularExpression(keyword));
+  return it.value();
+}
+
 Rc BranchMeta::parse(QStringList &argv, int index, Where &here)
 {
 /* DEBUG - COMMENT TO ENABLE
@@ -180,8 +194,7 @@ Rc BranchMeta::parse(QStringList &argv, int index, Where &here)
 
       if (index + offset < size) {
         for (i = list.begin(); i != list.end(); i++) {
-          rx.setPattern(i.key());
-          if (argv[index + offset].contains(rx)) {
+          if (argv[index + offset].contains(branchKeywordRx(i.key()))) {
             /* Now parse the rest of the argvs */
             i.value()->pushed = local;
             i.value()->global = global;
@@ -670,7 +683,7 @@ void StringListMeta::doc(QStringList &out, QString preamble)
 
 Rc BoolMeta::parse(QStringList &argv, int index,Where &here)
 {
-  rx.setPattern("^(TRUE|FALSE)$");
+  static const QRegularExpression rx("^(TRUE|FALSE)$");
   if (index == argv.size() - 1 && argv[index].contains(rx)) {
       _value[pushed] = argv[index] == "TRUE";
       _here[pushed] = here;
@@ -798,16 +811,22 @@ void PlacementMeta::setValue(
 
 Rc PlacementMeta::parse(QStringList &argv, int index,Where &here)
 {
+  static const QRegularExpression topBottomRx("^(TOP|BOTTOM)$");
+  static const QRegularExpression leftCenterRightRx("^(LEFT|CENTER|RIGHT)$");
+  static const QRegularExpression relativeToRx("^(PAGE|ASSEM|MULTI_STEP|STEP_NUMBER|PLI|CALLOUT|PAGE_NUMBER|"
+                                               "DOCUMENT_TITLE|MODEL_ID|DOCUMENT_AUTHOR|PUBLISH_URL|MODEL_DESCRIPTION|"
+                                               "PUBLISH_DESCRIPTION|PUBLISH_COPYRIGHT|PUBLISH_EMAIL|LEGO_DISCLAIMER|"
+                                               "MODEL_PARTS|APP_PLUG|MODEL_CATEGORY|DOCUMENT_LOGO|DOCUMENT_COVER_IMAGE|"
+                                               "APP_PLUG_IMAGE|PAGE_HEADER|PAGE_FOOTER|MODEL_CATEGORY|SUBMODEL_DISPLAY|"
+                                               "ROTATE_ICON|ASSEM_PART|STEP|RANGE|TEXT|BOM|PAGE_POINTER|SINGLE_STEP|RESERVE|"
+                                               "COVER_PAGE|ANNOTATION|DIVIDER_POINTER)$");
+  static const QRegularExpression leftRightRx("^(LEFT|RIGHT)$");
+  static const QRegularExpression topCenterBottomRx("^(TOP|CENTER|BOTTOM)$");
+  static const QRegularExpression cornerCenterRx("^(TOP_LEFT|TOP_RIGHT|BOTTOM_LEFT|BOTTOM_RIGHT|CENTER)$");
+  static const QRegularExpression prepositionRx("^(INSIDE|OUTSIDE)$");
   float _offsets[2];
   Rc rc = FailureRc;
   int argc = argv.size();
-  QString relativeTos = "^(PAGE|ASSEM|MULTI_STEP|STEP_NUMBER|PLI|CALLOUT|PAGE_NUMBER|"
-                        "DOCUMENT_TITLE|MODEL_ID|DOCUMENT_AUTHOR|PUBLISH_URL|MODEL_DESCRIPTION|"
-                        "PUBLISH_DESCRIPTION|PUBLISH_COPYRIGHT|PUBLISH_EMAIL|LEGO_DISCLAIMER|"
-                        "MODEL_PARTS|APP_PLUG|MODEL_CATEGORY|DOCUMENT_LOGO|DOCUMENT_COVER_IMAGE|"
-                        "APP_PLUG_IMAGE|PAGE_HEADER|PAGE_FOOTER|MODEL_CATEGORY|SUBMODEL_DISPLAY|"
-                        "ROTATE_ICON|ASSEM_PART|STEP|RANGE|TEXT|BOM|PAGE_POINTER|SINGLE_STEP|RESERVE|"
-                        "COVER_PAGE|ANNOTATION|DIVIDER_POINTER)$";
   _offsets[0]    = 0;
   _offsets[1]    = 0;
 
@@ -864,42 +883,35 @@ Rc PlacementMeta::parse(QStringList &argv, int index,Where &here)
   PlacementType _relativeTo; //_value[pushed].relativeTo;
   QString placement, justification, preposition, relativeTo;
 
-  rx.setPattern("^(TOP|BOTTOM)$");
-  if (argv[index].contains(rx)) {
+  if (argv[index].contains(topBottomRx)) {
     placement = argv[index++];
 
     if (index < argc) {
-      rx.setPattern("^(LEFT|CENTER|RIGHT)$");
-      if (argv[index].contains(rx)) {
+      if (argv[index].contains(leftCenterRightRx)) {
         justification = argv[index++];
         rc = OkRc;
       } else {
-        rx.setPattern(relativeTos);
-        if (argv[index].contains(rx)) {
+        if (argv[index].contains(relativeToRx)) {
           rc = OkRc;
         }
       }
     }
   } else {
-    rx.setPattern("^(LEFT|RIGHT)$");
-    if (argv[index].contains(rx)) {
+    if (argv[index].contains(leftRightRx)) {
       placement = argv[index++];
 
       if (index < argc) {
-        rx.setPattern("^(TOP|CENTER|BOTTOM)$");
-        if (argv[index].contains(rx)) {
+        if (argv[index].contains(topCenterBottomRx)) {
           justification = argv[index++];
           rc = OkRc;
         } else {
-          rx.setPattern(relativeTos);
-          if (argv[index].contains(rx)) {
+          if (argv[index].contains(relativeToRx)) {
             rc = OkRc;
           }
         }
       }
     } else {
-      rx.setPattern("^(TOP_LEFT|TOP_RIGHT|BOTTOM_LEFT|BOTTOM_RIGHT|CENTER)$");
-      if (argv[index].contains(rx)) {
+      if (argv[index].contains(cornerCenterRx)) {
         placement = argv[index++];
         rc = OkRc;
       } else {
@@ -909,12 +921,10 @@ Rc PlacementMeta::parse(QStringList &argv, int index,Where &here)
   }
 
   if (rc == OkRc && index < argv.size()) {
-    rx.setPattern(relativeTos);
-    if (argv[index].contains(rx)) {
+    if (argv[index].contains(relativeToRx)) {
       relativeTo = argv[index++];
       if (index < argc) {
-        rx.setPattern("^(INSIDE|OUTSIDE)$");
-        if (argv[index].contains(rx)) {
+        if (argv[index].contains(prepositionRx)) {
           preposition = argv[index++];
         }
         if (argc - index >= 2) {
@@ -1516,16 +1526,18 @@ Rc PointerAttribMeta::parse(QStringList &argv, int index, Where &here)
 
 PointerAttribData &PointerAttribMeta::parseAttributes(const QStringList &argv, const Where &here, const int indx, int &arge, Rc &rc)
 {
+  static const QRegularExpression attributeRx("^(LINE|BORDER|TIP)$");
+  static const QRegularExpression scopeRx("^(GLOBAL|LOCAL)$");
+  static const QRegularExpression attributeMetaRx("^(POINTER_ATTRIBUTE|DIVIDER_POINTER_ATTRIBUTE)$");
+  static const QRegularExpression tipIdRx("^(HIDE_TIP|ID)$");
+  static const QRegularExpression boolRx("^(TRUE|FALSE)$");
   QRegularExpressionMatch match;
   int index = indx;
-  rx.setPattern("^(LINE|BORDER|TIP)$");
   if (!index)
-    index = argv.indexOf(rx);
-  match = rx.match(argv[index]);
-  rx.setPattern("^(GLOBAL|LOCAL)$");
-  bool scoped = argv[index-1].contains(rx);
-  rx.setPattern("^(POINTER_ATTRIBUTE|DIVIDER_POINTER_ATTRIBUTE)$");
-  bool valid  = argv[index-(scoped ? 2 : 1)].contains(rx);
+    index = argv.indexOf(attributeRx);
+  match = attributeRx.match(argv[index]);
+  bool scoped = argv[index-1].contains(scopeRx);
+  bool valid  = argv[index-(scoped ? 2 : 1)].contains(attributeMetaRx);
   int type = PointerAttribData::Line;
 
   _result = _value[pushed];
@@ -1598,16 +1610,14 @@ PointerAttribData &PointerAttribMeta::parseAttributes(const QStringList &argv, c
   int tip_idIndex = -1, idIndex = -1;
 
   if (argv.size() > sizeIndex+1) {
-    rx.setPattern("^(HIDE_TIP|ID)$");
-    bool tip_idKey = argv[sizeIndex+1].contains(rx);
+    bool tip_idKey = argv[sizeIndex+1].contains(tipIdRx);
     tip_idIndex = tip_idKey ? sizeIndex+2 : sizeIndex+1;
     if (tip_idKey) {                       // if line (hide tip or id), else if border or tip (id)
       if (argv[sizeIndex+1] == "ID") {     // check if line  id
         id = argv[tip_idIndex].toInt(&ok); // id integer
         idIndex = tip_idIndex;
       } else {                             // set hide tip
-        rx.setPattern("^(TRUE|FALSE)$");
-        if ((ok = argv[tip_idIndex].contains(rx)))
+        if ((ok = argv[tip_idIndex].contains(boolRx)))
           hideTip = argv[tip_idIndex] == "TRUE";
       }
     }
@@ -1827,6 +1837,8 @@ PointerMeta::PointerMeta() : LeafMeta()
 
 Rc PointerMeta::parse(QStringList &argv, int index, Where &here)
 {
+  static const QRegularExpression cornerRx("^(TOP_LEFT|TOP_RIGHT|BOTTOM_LEFT|BOTTOM_RIGHT)$");
+  static const QRegularExpression sideRx("^(TOP|BOTTOM|LEFT|RIGHT|CENTER)$");
   int   _segments = 1;
   float _loc = 0.0, _base = -1.0;
   float _x1 = 0.0, _y1 = 0.0;
@@ -1867,10 +1879,9 @@ Rc PointerMeta::parse(QStringList &argv, int index, Where &here)
                 ;
 #endif
 //*/
-    rx.setPattern("^(TOP_LEFT|TOP_RIGHT|BOTTOM_LEFT|BOTTOM_RIGHT)$");
 
     // legacy single-segment pattern - base included
-    if (argv[index].contains(rx) && n_tokens == 4) {
+    if (argv[index].contains(cornerRx) && n_tokens == 4) {
       _loc = 0;
       bool ok[3];
       _x1   = argv[index+1].toFloat(&ok[0]);
@@ -1879,7 +1890,7 @@ Rc PointerMeta::parse(QStringList &argv, int index, Where &here)
       fail  = ! (ok[0] && ok[1] && ok[2]);
     }
     // legacy single-segment pattern - no base
-    if (argv[index].contains(rx) && n_tokens == 3) {
+    if (argv[index].contains(cornerRx) && n_tokens == 3) {
       _loc = 0;
       bool ok[2];
       _x1   = argv[index+1].toFloat(&ok[0]);
@@ -1887,7 +1898,7 @@ Rc PointerMeta::parse(QStringList &argv, int index, Where &here)
       fail  = ! (ok[0] && ok[1]);
     }
     // new multi-segment patterns (addl tokens: x2,y2,x3,y3,x4,y4,segments,[baseRect])
-    if (argv[index].contains(rx) && (pagePointer ? n_tokens == 12 : n_tokens == 11)) {
+    if (argv[index].contains(cornerRx) && (pagePointer ? n_tokens == 12 : n_tokens == 11)) {
       _loc = 0;
       bool ok[10];
       _x1       = argv[index+1].toFloat(&ok[0]);
@@ -1905,7 +1916,7 @@ Rc PointerMeta::parse(QStringList &argv, int index, Where &here)
       fail      = ! (ok[0] && ok[1] && ok[2] && ok[3] && ok[4] &&
                      ok[5] && ok[6] && ok[7] && ok[8] && ok[9]);
     }
-    if (argv[index].contains(rx) && (pagePointer ? n_tokens == 11 : n_tokens == 10)) {
+    if (argv[index].contains(cornerRx) && (pagePointer ? n_tokens == 11 : n_tokens == 10)) {
       _loc = 0;
       bool ok[9];
       _x1       = argv[index+1].toFloat(&ok[0]);
@@ -1922,8 +1933,7 @@ Rc PointerMeta::parse(QStringList &argv, int index, Where &here)
       fail      = ! (ok[0] && ok[1] && ok[2] && ok[3] && ok[4] &&
                      ok[5] && ok[6] && ok[7] && ok[8]);
     }
-    rx.setPattern("^(TOP|BOTTOM|LEFT|RIGHT|CENTER)$");
-    if (argv[index].contains(rx) && n_tokens == 5) {
+    if (argv[index].contains(sideRx) && n_tokens == 5) {
       bool ok[4];
       _loc  = argv[index+1].toFloat(&ok[0]);
       _x1    = argv[index+2].toFloat(&ok[1]);
@@ -1932,7 +1942,7 @@ Rc PointerMeta::parse(QStringList &argv, int index, Where &here)
       fail  = ! (ok[0] && ok[1] && ok[2] && ok[3]);
     }
     // legacy single-segment pattern - no base
-    if (argv[index].contains(rx) && n_tokens == 4) {
+    if (argv[index].contains(sideRx) && n_tokens == 4) {
       bool ok[3];
       _loc  = argv[index+1].toFloat(&ok[0]);
       _x1    = argv[index+2].toFloat(&ok[1]);
@@ -1940,7 +1950,7 @@ Rc PointerMeta::parse(QStringList &argv, int index, Where &here)
       fail  = ! (ok[0] && ok[1] && ok[2]);
     }
     // new multi-segment pattern (addl tokens: x2,y2,x3,y3,x4,y4,segments,[baseRect])
-    if (argv[index].contains(rx) && (pagePointer ? n_tokens == 13 : n_tokens == 12)) {
+    if (argv[index].contains(sideRx) && (pagePointer ? n_tokens == 13 : n_tokens == 12)) {
       bool ok[11];
       _loc      = argv[index+1].toFloat(&ok[0]);
       _x1       = argv[index+2].toFloat(&ok[1]);
@@ -1958,7 +1968,7 @@ Rc PointerMeta::parse(QStringList &argv, int index, Where &here)
       fail      = ! (ok[0] && ok[1] && ok[2] && ok[3] && ok[4] && ok[5] &&
                      ok[6] && ok[7] && ok[8] && ok[9] && ok[10]);
     }
-    if (argv[index].contains(rx) && (pagePointer ? n_tokens == 12 : n_tokens == 11)) {
+    if (argv[index].contains(sideRx) && (pagePointer ? n_tokens == 12 : n_tokens == 11)) {
       bool ok[10];
       _loc      = argv[index+1].toFloat(&ok[0]);
       _x1       = argv[index+2].toFloat(&ok[1]);
@@ -2064,7 +2074,7 @@ Rc PointerMeta::parse(QStringList &argv, int index, Where &here)
 
 QString PointerMeta::format(bool local, bool global)
 {
-  rx.setPattern("^\\s*0.*\\s+(PAGE POINTER|PAGE_POINTER)\\s+.*$");
+  static const QRegularExpression rx("^\\s*0.*\\s+(PAGE POINTER|PAGE_POINTER)\\s+.*$");
   bool pagePointer = preamble.contains(rx);
   QString foo;
   switch(_value[pushed].placement) {
@@ -2141,6 +2151,9 @@ void PointerMeta::metaKeywords(QStringList &out, QString preamble)
 //--------------
 Rc CsiAnnotationIconMeta::parse(QStringList &argv, int index,Where &here)
 {
+  static const QRegularExpression hideRx("^(HIDE|HIDDEN)$");
+  static const QRegularExpression placementRx("^(TOP_LEFT|TOP|TOP_RIGHT|LEFT|CENTER|RIGHT|BOTTOM_LEFT|BOTTOM|BOTTOM_RIGHT)$");
+  static const QRegularExpression prepositionRx("^(INSIDE|OUTSIDE)$");
 /* DEBUG - COMMENT TO ENABLE
 #ifdef QT_DEBUG_MODE
   QStringList debugLine = QStringList() << "[LINE:";
@@ -2170,28 +2183,25 @@ Rc CsiAnnotationIconMeta::parse(QStringList &argv, int index,Where &here)
   CsiAnnotationIconData annotationData;
   Rc rc = FailureRc;
   if (argv.size() - index == 1) {
-      rx.setPattern("^(HIDE|HIDDEN)$");
-      if (argv[index].contains(rx)) {
+      if (argv[index].contains(hideRx)) {
           annotationData.hidden = true;
           rc = OkRc;
       }
   }
   else
   if (argv.size() - index >= 10) {
-    rx.setPattern("^(TOP_LEFT|TOP|TOP_RIGHT|LEFT|CENTER|RIGHT|BOTTOM_LEFT|BOTTOM|BOTTOM_RIGHT)$");
     QStringList entries;
-    if (argv[index].contains(rx)) {
+    if (argv[index].contains(placementRx)) {
       entries << QString::number(PlacementEnc(tokenMap[argv[index]]));
       rc = OkRc;
     }
     if (argv.size() - index == 11) {
-      if (argv[++index].contains(rx)) {
+      if (argv[++index].contains(placementRx)) {
         entries << QString::number(PlacementEnc(tokenMap[argv[index]]));
         rc = OkRc;
       }
     }
-    rx.setPattern("^(INSIDE|OUTSIDE)$");
-    if (argv[++index].contains(rx)) {
+    if (argv[++index].contains(prepositionRx)) {
       entries << QString::number(PrepositionEnc(tokenMap[argv[index]]));
       rc = OkRc;
     }
@@ -2434,16 +2444,16 @@ FreeFormMeta::FreeFormMeta() : LeafMeta()
 }
 Rc FreeFormMeta::parse(QStringList &argv, int index,Where &here)
 {
+  static const QRegularExpression itemRx("^(STEP_NUMBER|ASSEM|PLI|ROTATE_ICON)$");
+  static const QRegularExpression placementRx("^(LEFT|RIGHT|TOP|BOTTOM|CENTER)$");
   Rc rc = FailureRc;
   if (argv.size() - index == 1 && argv[index] == "FALSE") {
     _value[pushed].mode = false;
     rc = OkRc;
   } else if (argv.size() - index == 2) {
     _value[pushed].mode = true;
-    rx.setPattern("^(STEP_NUMBER|ASSEM|PLI|ROTATE_ICON)$");
-    if (argv[index].contains(rx)) {
-      rx.setPattern("^(LEFT|RIGHT|TOP|BOTTOM|CENTER)$");
-      if (argv[index+1].contains(rx)) {
+    if (argv[index].contains(itemRx)) {
+      if (argv[index+1].contains(placementRx)) {
         _value[pushed].base = PlacementEnc(tokenMap[argv[index]]);
         _value[pushed].justification = PlacementEnc(tokenMap[argv[index+1]]);
         rc = OkRc;
@@ -2486,12 +2496,13 @@ ConstrainMeta::ConstrainMeta() : LeafMeta()
 
 Rc ConstrainMeta::parse(QStringList &argv, int index,Where &here)
 {
+  static const QRegularExpression areaSquareRx("^(AREA|SQUARE)$");
+  static const QRegularExpression constraintRx("^(WIDTH|HEIGHT|COLS)$");
   Rc rc = FailureRc;
   bool ok;
   switch(argv.size() - index) {
     case 1:
-      rx.setPattern("^(AREA|SQUARE)$");
-      if (argv[index].contains(rx)) {
+      if (argv[index].contains(areaSquareRx)) {
         _value[pushed].type = ConstrainData::PliConstrain(tokenMap[argv[index]]);
         rc = OkRc;
       }
@@ -2499,8 +2510,7 @@ Rc ConstrainMeta::parse(QStringList &argv, int index,Where &here)
     case 2:
       argv[index+1].toFloat(&ok);
       if (ok) {
-        rx.setPattern("^(WIDTH|HEIGHT|COLS)$");
-        if (argv[index].contains(rx)) {
+        if (argv[index].contains(constraintRx)) {
           _value[pushed].type = ConstrainData::PliConstrain(tokenMap[argv[index]]);
           switch (_value[pushed].type)
           {
@@ -2569,7 +2579,7 @@ AllocMeta::AllocMeta() : LeafMeta()
 
 Rc AllocMeta::parse(QStringList &argv, int index, Where &here)
 {
-  rx.setPattern("^(HORIZONTAL|VERTICAL)$");
+  static const QRegularExpression rx("^(HORIZONTAL|VERTICAL)$");
   if (argv.size() - index == 1 && argv[index].contains(rx)) {
       type[pushed] = AllocEnc(tokenMap[argv[index]]);
       _here[pushed] = here;
@@ -2610,12 +2620,13 @@ void CameraAnglesMeta::init(BranchMeta *parent, const QString name, Rc _rc)
 
 Rc CameraAnglesMeta::parse(QStringList &argv, int index, Where &here)
 {
+  static const QRegularExpression viewRx("^(FRONT|BACK|TOP|BOTTOM|LEFT|RIGHT|HOME|LAT_LON|DEFAULT)$");
+  static const QRegularExpression homeLatLonRx("^(HOME|LAT_LON)$");
   using namespace Options;
   using namespace CameraViews;
   QString message = QObject::tr("The specified latitude %1 or longitude %2 value is not within the mininum %3 or maximum %4 allowed \"%5\".");
-  rx.setPattern("^(FRONT|BACK|TOP|BOTTOM|LEFT|RIGHT|HOME|LAT_LON|DEFAULT)$");
   if (argv.size() - index == 1) {
-    if (argv[index].contains(rx)) {
+    if (argv[index].contains(viewRx)) {
       float latitude  = 30.0f;
       float longitude = 45.0f;
       CameraView cameraView  = static_cast<CameraView>(_value[pushed].map[argv[index]]);
@@ -2696,8 +2707,7 @@ Rc CameraAnglesMeta::parse(QStringList &argv, int index, Where &here)
     }
     message = QObject::tr("Expected <decimal> <decimal> (e.g. 23.0 45.0), but got \"%1\" %2") .arg(argv[index], argv.join(" "));
   } else if (argv.size() - index == 3) {
-    rx.setPattern("^(HOME|LAT_LON)$");
-    if (argv[index].contains(rx)) {
+    if (argv[index].contains(homeLatLonRx)) {
       bool ok[2];
       float latitude = argv[index+1].toFloat(&ok[0]);
       float longitude = argv[index+2].toFloat(&ok[1]);
@@ -2763,7 +2773,7 @@ FillMeta::FillMeta() : LeafMeta()
 
 Rc FillMeta::parse(QStringList &argv, int index, Where &here)
 {
-  rx.setPattern("^(ASPECT|STRETCH|TILE)$");
+  static const QRegularExpression rx("^(ASPECT|STRETCH|TILE)$");
   if (argv.size() - index == 1 && argv[index].contains(rx)) {
       type[pushed] = FillEnc(tokenMap[argv[index]]);
       _here[pushed] = here;
@@ -2808,7 +2818,7 @@ JustifyStepMeta::JustifyStepMeta() : LeafMeta()
 }
 Rc JustifyStepMeta::parse(QStringList &argv, int index, Where &here)
 {
-  rx.setPattern("^(JUSTIFY_LEFT|JUSTIFY_CENTER|JUSTIFY_CENTER_HORIZONTAL|JUSTIFY_CENTER_VERTICAL)$");
+  static const QRegularExpression rx("^(JUSTIFY_LEFT|JUSTIFY_CENTER|JUSTIFY_CENTER_HORIZONTAL|JUSTIFY_CENTER_VERTICAL)$");
   if (argv[index].contains(rx)) {
     if (argv.size() - index >= 1)
       _value[pushed].type = JustifyStepEnc(tokenMap[argv[index]]);
@@ -2865,7 +2875,7 @@ PageOrientationMeta::PageOrientationMeta() : LeafMeta()
 }
 Rc PageOrientationMeta::parse(QStringList &argv, int index, Where &here)
 {
-  rx.setPattern("^(PORTRAIT|LANDSCAPE)$");
+  static const QRegularExpression rx("^(PORTRAIT|LANDSCAPE)$");
   if (argv.size() - index == 1 && argv[index].contains(rx)) {
     type[pushed] = OrientationEnc(tokenMap[argv[index]]);
     _here[pushed] = here;
@@ -2912,7 +2922,7 @@ CountInstanceMeta::CountInstanceMeta() : LeafMeta()
 
 Rc CountInstanceMeta::parse(QStringList &argv, int index, Where &here)
 {
-  rx.setPattern("^(AT_TOP|AT_MODEL|AT_STEP|TRUE|FALSE)$");
+  static const QRegularExpression rx("^(AT_TOP|AT_MODEL|AT_STEP|TRUE|FALSE)$");
   if (argv.size() - index == 1 && argv[index].contains(rx)) {
       type[pushed]  = CountInstanceEnc(countInstanceMap[argv[index]]);;
       _here[pushed] = here;
@@ -2969,7 +2979,7 @@ ContStepNumMeta::ContStepNumMeta() : LeafMeta()
 
 Rc ContStepNumMeta::parse(QStringList &argv, int index, Where &here)
 {
-  rx.setPattern("^(TRUE|FALSE)$");
+  static const QRegularExpression rx("^(TRUE|FALSE)$");
   if (argv.size() - index == 1 && argv[index].contains(rx)) {
     type[pushed]  = ContStepNumEnc(contStepNumMap[argv[index]]);;
     _here[pushed] = here;
@@ -3019,7 +3029,7 @@ BuildModEnabledMeta::BuildModEnabledMeta() : LeafMeta()
 
 Rc BuildModEnabledMeta::parse(QStringList &argv, int index, Where &here)
 {
-  rx.setPattern("^(TRUE|FALSE)$");
+  static const QRegularExpression rx("^(TRUE|FALSE)$");
   if (argv.size() - index == 1 && argv[index].contains(rx)) {
     type[pushed]  = BuildModEnabledEnc(buildModEnabledMap[argv[index]]);
     _here[pushed] = here;
@@ -3071,7 +3081,7 @@ FinalModelEnabledMeta::FinalModelEnabledMeta() : LeafMeta()
 
 Rc FinalModelEnabledMeta::parse(QStringList &argv, int index, Where &here)
 {
-  rx.setPattern("^(TRUE|FALSE)$");
+  static const QRegularExpression rx("^(TRUE|FALSE)$");
   if (argv.size() - index == 1 && argv[index].contains(rx)) {
       type[pushed]  = FinalModelEnabledEnc(finalModelEnabledMap[argv[index]]);
       _here[pushed] = here;
@@ -3121,7 +3131,7 @@ void PageSizeMeta::init(
 }
 Rc PageSizeMeta::parse(QStringList &argv, int index,Where &here)
 {
-  rx.setPattern("^(PORTRAIT|LANDSCAPE)$");
+  static const QRegularExpression rx("^(PORTRAIT|LANDSCAPE)$");
   bool ok[2];
   bool sizeIDFound = false;
   bool sizeWandHFound = false;
@@ -3259,6 +3269,7 @@ SepMeta::SepMeta() : LeafMeta()
 }
 Rc SepMeta::parse(QStringList &argv, int index,Where &here)
 {
+  static const QRegularExpression rx("CUSTOM|CUSTOM_LENGTH"); // legacy
   Rc rc = FailureRc;
   bool good, ok;
   if (argv.size() - index == 4) {
@@ -3314,7 +3325,6 @@ Rc SepMeta::parse(QStringList &argv, int index,Where &here)
     }
   } else
   if (argv.size() - index == 6) {
-    rx.setPattern("CUSTOM|CUSTOM_LENGTH"); // legacy
     if (argv[index].contains(rx)) {
       argv[index+1].toFloat(&good);
       argv[index+2].toFloat(&ok);
@@ -3432,7 +3442,7 @@ void SepMeta::metaKeywords(QStringList &out, QString preamble)
 
 Rc SceneObjectMeta::parse(QStringList &argv, int index, Where &here)
 {
-  rx.setPattern("^(BRING_TO_FRONT|SEND_TO_BACK)$");
+  static const QRegularExpression rx("^(BRING_TO_FRONT|SEND_TO_BACK)$");
   if (argv.size() - index == 3 && argv[index].contains(rx)) {
     bool good, ok;
     float x = argv[index+1].toFloat(&good);
@@ -3504,9 +3514,9 @@ StudStyleMeta::StudStyleMeta() : LeafMeta()
 
 Rc StudStyleMeta::parse(QStringList &argv, int index, Where &here)
 {
+  static const QRegularExpression rx("^(NONE|PLAIN|THIN_LINE_LOGO|OUTLINE_TOP_LOGO|OUTLINE_LOGO|SHARP_TOP_LOGO|ROUNDED_TOP_LOGO|FLATTENED_TOP_LOGO|FLATTENED_LOGO|HIGH_CONTRAST_PLAIN|HIGH_CONTRAST|HIGH_CONTRAST_THIN_LINE|HIGH_CONTRAST_WITH_LOGO)$");
   Rc rc = OkRc;
   enabled[pushed] = false;
-  rx.setPattern("^(NONE|PLAIN|THIN_LINE_LOGO|OUTLINE_TOP_LOGO|OUTLINE_LOGO|SHARP_TOP_LOGO|ROUNDED_TOP_LOGO|FLATTENED_TOP_LOGO|FLATTENED_LOGO|HIGH_CONTRAST_PLAIN|HIGH_CONTRAST|HIGH_CONTRAST_THIN_LINE|HIGH_CONTRAST_WITH_LOGO)$");
   if (argv.size() - index == 1) {
     if (!argv[index].contains(rx)) {
       bool ok;
@@ -3595,8 +3605,8 @@ ColorMeta::ColorMeta() : RcMeta()
 
 Rc ColorMeta::parse(QStringList &argv, int index, Where &here)
 {
+  static const QRegularExpression rx("\\s*(0x|#)([\\da-fA-F]+)\\s*$");
   if (argv.size() - index == 1) {
-    rx.setPattern("\\s*(0x|#)([\\da-fA-F]+)\\s*$");
     QColor color;
     if (argv[index].contains(rx)) {
       color = QColor(argv[index]);
@@ -3722,7 +3732,8 @@ Rc InsertMeta::parse(QStringList &argv, int index, Where &here)
 
   if (rc != OkRc && !Gui::abortProcess()) {
     if (Gui::pageProcessRunning != PROC_NONE) {
-      static QRegularExpression errorRx;
+      static const QRegularExpression errorRx("(^[1-5]\\s+)|(\\bBEGIN SUB\\b)|(0 STEP|0 ROTSTEP)");
+      static const QRegularExpression stepRx("0 STEP|0 ROTSTEP");
       QRegularExpressionMatch match;
       QString line;
       bool errorFound = false;
@@ -3730,32 +3741,29 @@ Rc InsertMeta::parse(QStringList &argv, int index, Where &here)
       Where start(here.modelName,here.modelIndex,here.lineNumber);
       Where top(here.modelName,here.modelIndex,0);
       lpub->ldrawFile.skipHeader(top.modelName,top.lineNumber);
-      errorRx.setPattern("(^[1-5]\\s+)|(\\bBEGIN SUB\\b)|(0 STEP|0 ROTSTEP)");
-      rx.setPattern("0 STEP|0 ROTSTEP");
       for (; start.lineNumber > top.lineNumber; start--) {
         line = lpub->ldrawFile.readLine(start.modelName,start.lineNumber);
         match = errorRx.match(line);
         if (match.hasMatch()) {
-          errorFound = !match.captured(3).contains(rx);
+          errorFound = !match.captured(3).contains(stepRx);
           break;
         }
       }
 
       if (!errorFound) {
         start = here;
-        static QRegularExpression dispModRx;
-        errorRx.setPattern("^[1-5]\\s+|(\\bBEGIN SUB\\b)");
+        static const QRegularExpression partErrorRx("^[1-5]\\s+|(\\bBEGIN SUB\\b)");
+        static const QRegularExpression dispModRx("^0\\s+!?(?:LPUB)*\\s?(INSERT DISPLAY_MODEL)[^\n]*");
         if (lpub->ldrawFile.size(here.modelName) > here.lineNumber) {
           start++;                                            // advance past current line
         }
         if (displayModel) {                                     // check for substitute command
-          errorFound = Gui::stepContains(start, errorRx, line, 1, displayModel/*allow type 1-5 lines if display model*/);
+          errorFound = Gui::stepContains(start, partErrorRx, line, 1, displayModel/*allow type 1-5 lines if display model*/);
         } else {
           top = start;
-          dispModRx.setPattern("^0\\s+!?(?:LPUB)*\\s?(INSERT DISPLAY_MODEL)[^\n]*");
           if (! Gui::stepContains(top, dispModRx)) {           // Check if step contain display model
             line = QObject::tr("type 1-5 line");
-            errorFound = Gui::stepContains(start, errorRx); // check for type 1-5 parts
+            errorFound = Gui::stepContains(start, partErrorRx); // check for type 1-5 parts
           }
         }
       }
@@ -4491,8 +4499,8 @@ void SceneItemMeta::init(BranchMeta *parent, QString name)
 
 Rc EnableMeta::parse(QStringList &argv, int index, Where &here)
 {
+  static const QRegularExpression rx("^(TRUE|FALSE)$");
   Rc rc = FailureRc;
-  rx.setPattern("^(TRUE|FALSE)$");
   if (argv.size() - index == 1 && argv[index].contains(rx)) {
     _value[pushed] = argv[index] == "TRUE";
     _here[pushed] = here;
@@ -4552,8 +4560,8 @@ void EnableMeta::metaKeywords(QStringList &out, QString preamble)
 
 Rc LPubFaHiMeta::parse(QStringList &argv, int index, Where &here)
 {
+  static const QRegularExpression rx("^(TRUE|FALSE)$");
   Rc rc = FailureRc;
-  rx.setPattern("^(TRUE|FALSE)$");
   if (argv.size() - index == 1 && argv[index].contains(rx)) {
     _value[pushed] = argv[index] == "TRUE";
     _here[pushed] = here;
@@ -4613,11 +4621,11 @@ void LPubFaHiMeta::metaKeywords(QStringList &out, QString preamble)
 
 Rc FadeColorMeta::parse(QStringList &argv, int index, Where &here)
 {
+  static const QRegularExpression rx("^(0x|#)([\\da-fA-F]+)$");
   Rc rc = FailureRc;
   if (argv.size() - index >= 1) {
     QColor parsedColor = QColor();
     QRegularExpressionMatch match;
-    rx.setPattern("^(0x|#)([\\da-fA-F]+)$");
     match = rx.match(argv[index]);
     if (match.hasMatch())
       parsedColor = QColor(QString("#%1").arg(match.captured(2)));
@@ -4839,13 +4847,13 @@ void PartMeta::init(BranchMeta *parent, QString name)
 
 Rc SubMeta::parse(QStringList &argv, int index,Where &here)
 {
+  static const QRegularExpression rx("^(ABS|REL|ADD)$");
   bool ok[10];
   bool ldrawType = false;
   Rc rc = FailureRc;
   int argc = argv.size() - index;
   QString originalColor;
   QString attributes = "undefined;";
-  rx.setPattern("^(ABS|REL|ADD)$");
   if (argc > 0) {
     if ((ldrawType = argv[argv.size() - 2] == "LDRAW_TYPE")) {
       // the last item is an ldrawType - specified when substitute is a generated part
@@ -5084,6 +5092,7 @@ void PartIgnMeta::init(BranchMeta *parent, QString name)
 
 Rc RotStepMeta::parse(QStringList &argv, int index,Where &here)
 {
+  static const QRegularExpression rx("^(ABS|REL|ADD)$");
   if (argv.size() >= index+3 ) {
     bool ok[3];
     double rotX = argv[index+0].toDouble(&ok[0]);
@@ -5093,7 +5102,6 @@ Rc RotStepMeta::parse(QStringList &argv, int index,Where &here)
       _value.rots[0] = rotX;
       _value.rots[1] = rotY;
       _value.rots[2] = rotZ;
-      rx.setPattern("^(ABS|REL|ADD)$");
       if (argv.size() == index+4 && argv[index+3].contains(rx))
          _value.type   = argv[index+3];
       _value.populated = !(_value.rots[0] == 0 && _value.rots[1] == 0 && _value.rots[2] == 0);
@@ -5141,10 +5149,9 @@ void RotStepMeta::metaKeywords(QStringList &out, QString preamble)
 Rc BuffExchgMeta::parse(QStringList &argv, int index,Where &here)
 {
   if (index + 2 == argv.size()) {
-    static QRegularExpression tRx;
-    rx.setPattern("^[A-Z]$");
-    tRx.setPattern("^(STORE|RETRIEVE)$");
-    if (argv[index].contains(rx) && argv[index+1].contains(tRx)) {
+    static const QRegularExpression bufferRx("^[A-Z]$");
+    static const QRegularExpression tRx("^(STORE|RETRIEVE)$");
+    if (argv[index].contains(bufferRx) && argv[index+1].contains(tRx)) {
       _value.buffer = argv[index];
       _here[0] = here;
       _here[1] = here;
@@ -5181,9 +5188,9 @@ void BuffExchgMeta::metaKeywords(QStringList &out, QString preamble)
 
 Rc BuildModMeta::parse(QStringList &argv, int index, Where &here)
 {
+  static const QRegularExpression rx("^(BEGIN|END_MOD|END|APPLY|REMOVE)$");
   Rc rc = FailureRc;
   QString missingMeta;
-  rx.setPattern("^(BEGIN|END_MOD|END|APPLY|REMOVE)$");
   if (index + 1 == argv.size()) {
     if (argv[index].contains(rx)) {
       if (argv[index] == "BEGIN")
@@ -5201,8 +5208,7 @@ Rc BuildModMeta::parse(QStringList &argv, int index, Where &here)
       _here[1] = here;
     }
   } else if (index + 2 == argv.size()) {
-    static QRegularExpression keyRx;
-    keyRx.setPattern("^.*$");
+    static const QRegularExpression keyRx("^.*$");
     if (argv[index].contains(rx) && argv[index + 1].contains(keyRx)) {
       if (argv[index] == "BEGIN")
         rc = BuildModBeginRc;
@@ -7346,12 +7352,172 @@ void Meta::init(BranchMeta * /* unused */, QString /* unused */)
   }
 }
 
+/*
+ * Compiled trie over the top level meta keywords. Meta::parse walks it
+ * with a view of the keyword so lines that cannot be meta commands,
+ * comments for example, are dismissed without being split into argv.
+ */
+
+class MetaKeywordTrie
+{
+public:
+  MetaKeywordTrie(const QStringList &keywords)
+  {
+    nodes.append(Node());
+    for (const QString &keyword : keywords) {
+      int node = 0;
+      for (const QChar &c : keyword) {
+        int next = child(node, c);
+        if (next == -1) {
+          next = nodes.size();
+          nodes[node].edges.append(qMakePair(c, next));
+          nodes.append(Node());
+        }
+        node = next;
+      }
+      nodes[node].keyword = true;
+    }
+  }
+
+  bool contains(const QString &line, int start, int length) const
+  {
+    int node = 0;
+    for (int i = start; i < start + length; i++) {
+      node = child(node, line.at(i));
+      if (node == -1)
+        return false;
+    }
+    return nodes.at(node).keyword;
+  }
+
+private:
+  struct Node
+  {
+    QVector<QPair<QChar, int> > edges;
+    bool keyword = false;
+  };
+
+  int child(int node, QChar c) const
+  {
+    for (const QPair<QChar, int> &edge : nodes.at(node).edges)
+      if (edge.first == c)
+        return edge.second;
+    return -1;
+  }
+
+  QVector<Node> nodes;
+};
+
+/*
+ * Case insensitive match of the word at start in line against an
+ * upper case keyword, without taking a copy of the word.
+ */
+
+static bool wordEquals(const QString &line, int start, int length, const char *keyword)
+{
+  if (length != int(qstrlen(keyword)))
+    return false;
+  for (int i = 0; i < length; i++)
+    if (line.at(start + i).toUpper() != QLatin1Char(keyword[i]))
+      return false;
+  return true;
+}
+
+/*
+ * Cheap scan of the meta keyword and the word after it so the
+ * groupRegExMap patterns are only matched against lines that can be
+ * MLCAD BTG, LDCAD GROUP_NXT or LPUB/LEOCAD GROUP metas.
+ */
+
+bool Meta::maybeGroupMeta(const QString &line)
+{
+  const int size = line.size();
+  int pos = 0;
+
+  auto skipSpace = [&] () {
+    const int start = pos;
+    while (pos < size && line.at(pos).isSpace())
+      pos++;
+    return pos > start;
+  };
+
+  auto word = [&] (int &start, int &length) {
+    start = pos;
+    while (pos < size && !line.at(pos).isSpace())
+      pos++;
+    length = pos - start;
+  };
+
+  skipSpace();
+  if (pos >= size || line.at(pos) != QLatin1Char('0'))
+    return false;
+  pos++;
+  if (!skipSpace())
+    return false;
+  if (pos < size && line.at(pos) == QLatin1Char('!'))
+    pos++;
+
+  int keyword, keywordLength, command, commandLength;
+  word(keyword, keywordLength);
+  if (!skipSpace())
+    return false;
+  word(command, commandLength);
+
+  if (wordEquals(line, keyword, keywordLength, "MLCAD"))
+    return wordEquals(line, command, commandLength, "BTG");
+  if (wordEquals(line, keyword, keywordLength, "LDCAD"))
+    return wordEquals(line, command, commandLength, "GROUP_NXT");
+  if (wordEquals(line, keyword, keywordLength, "LPUB") ||
+      wordEquals(line, keyword, keywordLength, "LEOCAD"))
+    return wordEquals(line, command, commandLength, "GROUP");
+
+  return false;
+}
+
+/*
+ * Returns false when the keyword following the line type cannot select
+ * a meta command. Lines whose leading words split() would treat
+ * differently, quoted or tab separated ones, are left to the full parse.
+ */
+
+bool Meta::maybeMetaCommand(const QString &line)
+{
+  static const MetaKeywordTrie keywordTrie(list.keys() << "LPUB" << "PLIST" << "GHOST");
+
+  const int size = line.size();
+  int pos = 0;
+
+  auto word = [&] (int &start, int &length) {
+    while (pos < size && line.at(pos) == QLatin1Char(' '))
+      pos++;
+    start = pos;
+    while (pos < size && line.at(pos) != QLatin1Char(' ')) {
+      const QChar c = line.at(pos);
+      if (c == QLatin1Char('"') || c.isSpace())
+        return false;
+      pos++;
+    }
+    length = pos - start;
+    return true;
+  };
+
+  int type, typeLength, keyword, keywordLength;
+  if (!word(type, typeLength) || !typeLength || line.at(type) != QLatin1Char('0'))
+    return true;
+  if (!word(keyword, keywordLength))
+    return true;
+
+  return keywordTrie.contains(line, keyword, keywordLength);
+}
+
 Rc Meta::parse( QString &line,Where &here, bool reportErrors)
 {
   AbstractMeta::reportErrors = reportErrors;
 
   auto parseGroupMeta = [&line]()
   {
+    if (!maybeGroupMeta(line))
+      return QStringList();
     QHash<Rc, QRegularExpression>::const_iterator i = groupRegExMap.constBegin();
     QRegularExpressionMatch match;
     while (i != groupRegExMap.constEnd()) {
@@ -7367,6 +7533,9 @@ Rc Meta::parse( QString &line,Where &here, bool reportErrors)
 
   if (argv.isEmpty()) {
 
+    if (!maybeMetaCommand(line))
+      return OkRc;
+
     processSpecialCases(line,here);
 
     /* Parse the input line into argv[] */
@@ -7521,9 +7690,8 @@ void Meta::metaKeywords(QStringList &out, bool highlighter)
 }
 
 void Meta::processSpecialCases(QString &line, Where &here) {
-  QRegularExpressionMatch match;
-  rx.setPattern("\\s+(VIEW_ANGLE|MODEL_PIECES|BLENDER_DIRECTIONAL_ANGLE|COLOR_RGB|CAMERA_DISTANCE_NATIVE)\\s+");
-  match = rx.match(line);
+  static const QRegularExpression specialCasesRx("\\s+(VIEW_ANGLE|MODEL_PIECES|BLENDER_DIRECTIONAL_ANGLE|COLOR_RGB|CAMERA_DISTANCE_NATIVE)\\s+");
+  QRegularExpressionMatch match = specialCasesRx.match(line);
   if (!match.hasMatch())
     return;
 
@@ -7556,8 +7724,8 @@ void Meta::processSpecialCases(QString &line, Where &here) {
     if (Gui::parsedMessages.contains(here)) {
       line = "0 // IGNORED";
     } else if (Gui::pageProcessRunning == PROC_WRITE_TO_TMP) {
-      rx.setPattern("\\s+(ASSEM|PLI|BOM|SUBMODEL|LOCAL)\\s+");
-      if (line.contains(rx)) {
+      static const QRegularExpression scopeRx("\\s+(ASSEM|PLI|BOM|SUBMODEL|LOCAL)\\s+");
+      if (line.contains(scopeRx)) {
         QString const message = QObject::tr("CAMERA_DISTANCE_NATIVE meta command is no longer supported for %1 type. "
                                             "Only application at GLOBAL scope is permitted. "
                                             "Reclassify or remove this command and use MODEL_SCALE to implicate camera distance. "
@@ -292,7 +292,6 @@ public:
   QString   preamble;
 
   static bool reportErrors;
-  static QRegularExpression rx;
 
   AbstractMeta()
   {
@@ -4048,6 +4047,7 @@ public:
   void  doc(QStringList &out);
   void  metaKeywords(QStringList &out, bool = false);
   void  processSpecialCases(QString &, Where &);
+  static bool maybeGroupMeta(const QString &line);
   Meta (const Meta &rhs) : BranchMeta(rhs)
   {
     QString empty;
@@ -4068,6 +4068,7 @@ public:
   }
 
 private:
+  bool  maybeMetaCommand(const QString &line);
 };
 
 extern const QString relativeNames[];
@@ -943,6 +943,8 @@ void Gui::closeFileOperations()
   }
   Gui::topOfPages.clear();
   Gui::pageSizes.clear();
+  pageCountRevisions.clear();
+  pageCountSummary = PageCountSummary();
   gui->undoStack->clear();
   Gui::pageDirection = PAGE_NEXT;
   Gui::buildModJumpForward = false;
@@ -1185,8 +1187,10 @@ void Gui::enableLPubFadeOrHighlight(bool enableFadeSteps, bool enableHighlightSt
   });
   if (waitForFinish)
       future.waitForFinished();
-  else
+  else {
+      gui->pageCountWatched = false;
       gui->futureWatcher.setFuture(future);
+  }
 }
 
 void Gui::updateRecentFileActions()
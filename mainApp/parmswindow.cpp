@@ -475,6 +475,16 @@ void ParmsWindow::displayParmsFile(
       viewLogWindowSettings();
       _restartRequired = false;
     }
+    else if (fileInfo.fileName().startsWith("stderr-ldview-")) {
+      title = QString("Standard error - LDView Worker %1").arg(fileInfo.fileName().section('-', 2));
+      viewLogWindowSettings();
+      _restartRequired = false;
+    }
+    else if (fileInfo.fileName().startsWith("stdout-ldview-")) {
+      title = QString("Standard output - LDView Worker %1").arg(fileInfo.fileName().section('-', 2));
+      viewLogWindowSettings();
+      _restartRequired = false;
+    }
     else {
       title = fileInfo.fileName();
       _restartRequired = false;
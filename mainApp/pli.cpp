@@ -52,6 +52,7 @@
 #include "ranges_element.h"
 #include "range_element.h"
 #include "dependencies.h"
+#include "imagecache.h"
 
 #include "pieceinf.h"
 #include "lc_viewwidget.h"
@@ -1239,14 +1240,30 @@ int Pli::createPartImage(
                     out << line << lpub_endl;
                 part.close();
 
-                // feed DAT to renderer
-                if ((renderer->renderPli(ldrNames,renderImageName,*meta,pliType,keySub) != 0)) {
+                // content key - the part file and every value that impacts the image
+                QStringList cacheParameters = QStringList()
+                        << QString::number(Preferences::preferredRenderer)
+                        << QString("%1_%2_%3").arg(pliType).arg(keySub).arg(pT)
+                        << nameKeys.mid(nPageWidth).join("_")
+                        << targetPosition
+                        << rotStep
+                        << pliMeta.ldviewParms.value() << pliMeta.ldgliteParms.value() << pliMeta.povrayParms.value()
+                        << QString("%1_%2").arg(meta->LPub.studStyle.value()).arg(pliMeta.studStyle.value());
+                QByteArray pliCacheKey = ImageCache::key(pliFile, cacheParameters);
+
+                // use an existing image rendered from identical content or feed DAT to renderer
+                if (ImageCache::share(renderImageName, pliCacheKey)) {
+                    emit gui->messageSig(LOG_DEBUG,QObject::tr("PLI [%1] image %2 shared from image cache.")
+                                         .arg(PartTypeNames[pT], QFileInfo(renderImageName).fileName()));
+                } else if ((renderer->renderPli(ldrNames,renderImageName,*meta,pliType,keySub) != 0)) {
                     emit gui->messageSig(LOG_ERROR,QObject::tr("%1 PLI [%2] render failed for<br>[%3]")
                                          .arg(rendererNames[Render::getRenderer()],
                                               PartTypeNames[pT],
                                               imageName));
                     imageName = QString(":/resources/missingimage.png");
                     ptRc = -1;
+                } else {
+                    ImageCache::insert(renderImageName, pliCacheKey);
                 }
             }
         }
@@ -29,6 +29,7 @@
 #include <QUrl>
 #include <QProcess>
 #include <QErrorMessage>
+#include <QtConcurrent>
 #include <algorithm>
 
 #include <LDVQt/LDVWidget.h>
@@ -965,7 +966,47 @@ void Gui::exportAsPdf()
       float pageHeightIn;
       QPageLayout pageLayout;
   };
-  QMap<int, PdfPage> pages;
+
+  // Page images are painted to the pdfWriter on a single pool thread so each
+  // page is embedded and compressed while the next page is drawn on this
+  // thread. One thread keeps the pages in document order.
+  QThreadPool pdfWriterPool;
+  pdfWriterPool.setMaxThreadCount(1);
+  QPainter pdfPainter;
+  QList<QFuture<void> > pdfPageFutures;
+
+  auto finishPdfPages = [&] (int pending)
+  {
+      while (pdfPageFutures.size() > pending)
+          pdfPageFutures.takeFirst().waitForFinished();
+  };
+
+  auto writePdfPage = [&] (const PdfPage &pdfPage, bool newPage)
+  {
+      finishPdfPages(1);
+      pdfPageFutures.append(QtConcurrent::run(&pdfWriterPool, [&pdfWriter, &pdfPainter, pdfPage, newPage] () {
+          if (!pdfPainter.isActive())
+              pdfPainter.begin(&pdfWriter);
+          pdfPainter.drawImage(QRect(0,0,
+                                     int(pdfWriter.logicalDpiX()*pdfPage.pageWidthIn),
+                                     int(pdfWriter.logicalDpiY()*pdfPage.pageHeightIn)),
+                               pdfPage.image);
+          // prepare to render next page
+          if (newPage) {
+              pdfWriter.setPageLayout(pdfPage.pageLayout);
+              pdfWriter.newPage();
+          }
+      }));
+  };
+
+  auto endPdfPages = [&] ()
+  {
+      finishPdfPages(0);
+      QtConcurrent::run(&pdfWriterPool, [&pdfPainter] () {
+          if (pdfPainter.isActive())
+              pdfPainter.end();
+      }).waitForFinished();
+  };
 
   if (Gui::processOption != EXPORT_PAGE_RANGE) {
 
@@ -1006,6 +1047,8 @@ void Gui::exportAsPdf()
           if (! Gui::exporting()) {
               if (exportPdfElements)
                   painter.end();
+              else
+                  endPdfPages();
               message = tr("Export to pdf terminated before completion. %1 pages of %2 processed%3.")
                            .arg(Gui::displayPageNum - 1).arg(_maxPages).arg(gui->elapsedTime(exportTimer.elapsed()));
               emit gui->messageSig(LOG_INFO_STATUS,message);
@@ -1091,27 +1134,24 @@ void Gui::exportAsPdf()
                   pdfWriter.newPage();
               }
           } else {
-              // store the image and required page attributes
+              // wrap up paint to image
+              painter.end();
+
+              // hand the image and required page attributes to the pdfWriter thread
               gui->getExportPageSize(pageWidthIn, pageHeightIn, Inches);
               PdfPage pdfPage;
               pdfPage.image       = image;
               pdfPage.pageWidthIn  = pageWidthIn;
               pdfPage.pageHeightIn = pageHeightIn;
 
-              // store pdfWriter next page layout
-              if(Gui::displayPageNum < _maxPages) {
+              // pdfWriter next page layout
+              const bool newPage = Gui::displayPageNum < _maxPages;
+              if (newPage) {
                   bool nextPage = true;
                   pdfPage.pageLayout = getPageLayout(nextPage);
               }
 
-              // store the rendered page
-              QMap<int, PdfPage>::iterator i = pages.find(Gui::displayPageNum);
-              if (i != pages.end())
-                  pages.erase(i);
-              pages.insert(Gui::displayPageNum,pdfPage);
-
-              // wrap up paint to image
-              painter.end();
+              writePdfPage(pdfPage, newPage);
           }
       } // end of step 1. generate page pixmaps
 
@@ -1122,58 +1162,8 @@ void Gui::exportAsPdf()
           // wrap up paint to pdfWriter
           painter.end();
       } else {
-          // step 2. paint generated page pixmaps to the pdfWriter
-          painter.begin(&pdfWriter);
-
-          if (Preferences::modeGUI)
-              gui->m_progressDialog->setRange(1,pages.count());
-
-          const QList keys = pages.keys();
-          for (int page : keys) {
-
-              message = tr("Step 2. Exporting pdf document page %1 of %2").arg(page).arg(pages.count());
-              emit gui->messageSig(LOG_INFO_STATUS,message);
-
-              if (Preferences::modeGUI) {
-                  gui->m_progressDialog->setLabelText(message);
-                  gui->m_progressDialog->setValue(page);
-                  QApplication::processEvents();
-              }
-
-              if (! Gui::exporting()) {
-                  painter.end();
-                  message = tr("Export to pdf terminated before completion. %2 pages of %3 processed%4.")
-                                .arg(page).arg(pages.count()).arg(Gui::elapsedTime(exportTimer.elapsed()));
-                  emit gui->messageSig(LOG_INFO_STATUS,message);
-                  if (Preferences::modeGUI) {
-                      QApplication::restoreOverrideCursor();
-                      gui->m_progressDialog->setBtnToClose();
-                      gui->m_progressDialog->setLabelText(message, true/*alert*/);
-                  }
-                  emit gui->setExportingSig(false);
-                  restoreCurrentPage();
-                  return;
-              }
-
-              // render this page's image to the pdfWriter
-              painter.drawImage(QRect(0,0,
-                                       int(pdfWriter.logicalDpiX()*pages[page].pageWidthIn),
-                                       int(pdfWriter.logicalDpiY()*pages[page].pageHeightIn)),
-                                       pages[page].image);
-
-              // prepare to render next page
-              if(page < pages.count()) {
-                  pdfWriter.setPageLayout(pages[page].pageLayout);
-                  pdfWriter.newPage();
-              }
-          }
-
-          if (Preferences::modeGUI)
-              gui->m_progressDialog->setValue(pages.count());
-
-          // wrap up paint to pdfWriter
-          pages.clear();
-          painter.end();
+          // wait for the pdfWriter thread to paint the outstanding pages
+          endPdfPages();
       }
 
   } else {
@@ -1226,6 +1216,8 @@ void Gui::exportAsPdf()
           if (! Gui::exporting()) {
               if (exportPdfElements)
                   painter.end();
+              else
+                  endPdfPages();
               message = tr("Export to pdf terminated before completion. %2 pages of %3 processed%4.")
                             .arg(_pageCount).arg(printPages.count()).arg(Gui::elapsedTime(exportTimer.elapsed()));
               emit gui->messageSig(LOG_INFO_STATUS,message);
@@ -1315,27 +1307,24 @@ void Gui::exportAsPdf()
                   pdfWriter.newPage();
               }
           } else {
-              // store the image and required page attributes
+              // wrap up
+              painter.end();
+
+              // hand the image and required page attributes to the pdfWriter thread
               gui->getExportPageSize(pageWidthIn, pageHeightIn, Inches);
               PdfPage pdfPage;
               pdfPage.image       = image;
               pdfPage.pageWidthIn  = pageWidthIn;
               pdfPage.pageHeightIn = pageHeightIn;
 
-              // store pdfWriter next page layout
-              if(_pageCount < printPages.count()) {
+              // pdfWriter next page layout
+              const bool newPage = _pageCount < printPages.count();
+              if (newPage) {
                   bool nextPage = true;
                   pdfPage.pageLayout = getPageLayout(nextPage);
               }
 
-              // store the rendered page
-              QMap<int, PdfPage>::iterator i = pages.find(Gui::displayPageNum);
-              if (i != pages.end())
-                  pages.erase(i);
-              pages.insert(Gui::displayPageNum,pdfPage);
-
-              // wrap up
-              painter.end();
+              writePdfPage(pdfPage, newPage);
           }
       } // end of step 1. generate page pixmaps
 
@@ -1346,59 +1335,9 @@ void Gui::exportAsPdf()
           // wrap up paint to pdfWriter
           painter.end();
       } else {
-          // step 2. paint generated page pixmaps to the pdfWriter
-          painter.begin(&pdfWriter);
-
-          if (Preferences::modeGUI)
-              gui->m_progressDialog->setRange(1,pages.count());
-
-          const QList keys = pages.keys();
-          for (int page : keys) {
-
-              message = tr("Step 2. Exporting pdf document page %1 of %2").arg(page).arg(pages.count());
-              emit gui->messageSig(LOG_INFO_STATUS,message);
-
-              if (Preferences::modeGUI) {
-                  gui->m_progressDialog->setLabelText(message);
-                  gui->m_progressDialog->setValue(page);
-                  QApplication::processEvents();
-              }
-
-              if (! Gui::exporting()) {
-                  painter.end();
-                  message = tr("Export to pdf terminated before completion. %2 pages of %3 processed%4.")
-                                .arg(page).arg(pages.count()).arg(Gui::elapsedTime(exportTimer.elapsed()));
-                  emit gui->messageSig(LOG_INFO_STATUS,message);
-                  if (Preferences::modeGUI) {
-                      QApplication::restoreOverrideCursor();
-                      gui->m_progressDialog->setBtnToClose();
-                      gui->m_progressDialog->setLabelText(message, true/*alert*/);
-                  }
-                  emit gui->setExportingSig(false);
-                  restoreCurrentPage();
-                  return;
-              }
-
-              // render this page's image to the pdfWriter
-              painter.drawImage(QRect(0,0,
-                                 int(pdfWriter.logicalDpiX()*pages[page].pageWidthIn),
-                                 int(pdfWriter.logicalDpiY()*pages[page].pageHeightIn)),
-                                 pages[page].image);
-
-              // prepare to render next page
-              if(page < pages.count()) {
-                  pdfWriter.setPageLayout(pages[page].pageLayout);
-                  pdfWriter.newPage();
-              }
-          }
-
-          if (Preferences::modeGUI)
-              gui->m_progressDialog->setValue(pages.count());
-
-          // wrap up paint to pdfWriter
-          pages.clear();
-          painter.end();
-      } // end of step 2. paint generated page pixmaps to the pdfWriter
+          // wait for the pdfWriter thread to paint the outstanding pages
+          endPdfPages();
+      } // end of wait for the pdfWriter thread
   }
 
   // hide progress bar
@@ -1619,6 +1558,38 @@ void Gui::exportAs(const QString &_suffix)
   // calculate device pixel ratio
   qreal dpr = Gui::exportPixelRatio;
 
+  // Page layout and scene rasterisation stay on this thread. Encoding and
+  // writing each page image is handed to the thread pool so the next page
+  // is drawn while previous pages are compressed and saved.
+  QList<QFuture<QString> > pageWriteFutures;
+  const int maxPageWrites = qMax(1, QThread::idealThreadCount());
+
+  auto finishPageWrites = [&] (int pending)
+  {
+      while (pageWriteFutures.size() > pending) {
+          const QString error = pageWriteFutures.takeFirst().result();
+          if (!error.isEmpty())
+              emit gui->messageSig(LOG_WARNING,error);
+      }
+  };
+
+  auto writePageImage = [&] (const QImage &image, const QString &imageFile)
+  {
+      finishPageWrites(maxPageWrites - 1);
+      pageWriteFutures.append(QtConcurrent::run([image, imageFile, suffix, type] () {
+          QImageWriter Writer(imageFile);
+          if (Writer.format().isEmpty())
+              Writer.setFormat(qPrintable(suffix));
+          if (!Writer.write(image))
+              return QObject::tr("Failed to export %1 %2 file:<br>[%3].<br>Reason: %4.")
+                                 .arg(suffix,
+                                      type,
+                                      imageFile,
+                                      Writer.errorString());
+          return QString();
+      }));
+  };
+
   // initialize progress dialogue
   QString message = tr("instructions to %1 to %2...").arg(type, suffix);
 
@@ -1654,6 +1625,7 @@ void Gui::exportAs(const QString &_suffix)
                   gui->m_progressDialog->setBtnToClose();
                   gui->m_progressDialog->setLabelText(message, true/*alert*/);
               }
+              finishPageWrites(0);
               emit gui->setExportingSig(false);
               restoreCurrentPage();
               return;
@@ -1733,22 +1705,13 @@ void Gui::exportAs(const QString &_suffix)
               gui->KexportScene.render(&painter);
               Gui::clearPage();
 
+              painter.end();
+
               // save the image to the selected directory
               // internationalization of "_page_"?
               QString pn = QString::number(Gui::displayPageNum);
               QString const imageFile = QDir::toNativeSeparators(directoryName + QDir::separator() + baseName + "_page_" + pn + "." + suffix.toLower());
-              QImageWriter Writer(imageFile);
-              if (Writer.format().isEmpty())
-                  Writer.setFormat(qPrintable(suffix));
-              if (!Writer.write(image)) {
-                  message = QObject::tr("Failed to export %1 %2 file:<br>[%3].<br>Reason: %4.")
-                                        .arg(suffix,
-                                             type,
-                                             imageFile,
-                                             Writer.errorString());
-                  emit gui->messageSig(LOG_WARNING,message);
-              }
-              painter.end();
+              writePageImage(image, imageFile);
           }
       }
 
@@ -1773,6 +1736,7 @@ void Gui::exportAs(const QString &_suffix)
                   gui->m_progressDialog->setBtnToClose();
                   gui->m_progressDialog->setLabelText(message, true/*alert*/);
               }
+              finishPageWrites(0);
               emit gui->setExportingSig(false);
               restoreCurrentPage();
               return;
@@ -1853,28 +1817,22 @@ void Gui::exportAs(const QString &_suffix)
               gui->KexportScene.render(&painter);
               Gui::clearPage();
 
+              painter.end();
+
               // save the image to the selected directory
               // internationalization of "_page_"?
               QString pn = QString::number(Gui::displayPageNum);
               QString const imageFile = QDir::toNativeSeparators(directoryName + QDir::separator() + baseName + "_page_" + pn + "." + suffix.toLower());
-              QImageWriter Writer(imageFile);
-              if (Writer.format().isEmpty())
-                  Writer.setFormat(qPrintable(suffix));
-              if (!Writer.write(image)) {
-                  message = QObject::tr("Failed to export %1 %2 file:<br>[%3].<br>Reason: %4.")
-                                        .arg(suffix,
-                                             type,
-                                             imageFile,
-                                             Writer.errorString());
-                  emit gui->messageSig(LOG_WARNING,message);
-              }
-              painter.end();
+              writePageImage(image, imageFile);
           }
       }
       if (Preferences::modeGUI)
           gui->m_progressDialog->setValue(printPages.count());
     }
 
+    // wait for outstanding page image writes
+    finishPageWrites(0);
+
     // hide progress bar
     if (Preferences::modeGUI) {
       QApplication::restoreOverrideCursor();
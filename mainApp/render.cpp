@@ -710,34 +710,122 @@ int Render::executeLDViewProcess(QStringList &arguments, QStringList &environmen
 //#endif
   ldviewEnvVars << systemEnvVars;
 
-  QProcess ldview;
-  ldview.setEnvironment(ldviewEnvVars);
-  ldview.setWorkingDirectory(QDir::currentPath() + QDir::separator() +  Paths::tmpDir);
-  ldview.setStandardErrorFile(QDir::currentPath() + QDir::separator() + "stderr-ldview");
-  ldview.setStandardOutputFile(QDir::currentPath() + QDir::separator() + "stdout-ldview");
-
-  ldview.start(Preferences::ldviewExe,arguments);
-  if ( ! ldview.waitForFinished(rendererTimeout())) {
-      if (ldview.exitCode() != 0 || 1) {
-          const QString result(ldview.readAll());
-          emit gui->messageSig(LOG_ERROR,QObject::tr("LDView %1 %2 render failed with code %3 %4")
-                               .arg(useLDViewSCall() ? "(SingleCall)" : "(Default)")
-                               .arg(render)
-                               .arg(ldview.exitCode())
-                               .arg(result));
-          return -1;
-        }
-    }
-
   bool usingInputFileList = false;
-  for (QString &argument : arguments) {
+  int listArgumentIndex = -1;
+  for (int i = 0; i < arguments.size(); i++) {
+      const QString &argument = arguments.at(i);
       if (argument.startsWith("-CommandLinesList=") ||
           argument.startsWith("-SaveSnapshotsList=")) {
           usingInputFileList = true;
+          listArgumentIndex = i;
           break;
       }
   }
 
+  // Split a single call input list across worker processes. Each worker
+  // loads the LDraw library once and renders its share of the list.
+  QList<QStringList> workerArguments;
+  QStringList workerListFileNames;
+  workerArguments << arguments;
+
+  int workers = qBound(1, Preferences::ldviewRenderWorkers, LDVIEW_RENDER_WORKERS_MAX);
+  if (usingInputFileList && workers > 1) {
+      const QString listArgument = arguments.at(listArgumentIndex);
+      const QString listKey = listArgument.section('=', 0, 0);
+      const QString listFileName = listArgument.section('=', 1);
+      QStringList listLines;
+      QFile listFile(listFileName);
+      if (listFile.open(QFile::ReadOnly | QFile::Text)) {
+          QTextStream in(&listFile);
+          while ( ! in.atEnd()) {
+              const QString line = in.readLine();
+              if (!line.trimmed().isEmpty())
+                  listLines << line;
+          }
+          listFile.close();
+      }
+
+      workers = qMin(workers, listLines.size() / SNAPSHOTS_LIST_THRESHOLD);
+      if (workers > 1) {
+          workerArguments.clear();
+          const int chunk = (listLines.size() + workers - 1) / workers;
+          for (int worker = 0; worker < workers && worker * chunk < listLines.size(); worker++) {
+              const QString workerListFileName = QString("%1_%2.%3")
+                      .arg(QFileInfo(listFileName).absolutePath() + QDir::separator() + QFileInfo(listFileName).completeBaseName())
+                      .arg(worker)
+                      .arg(QFileInfo(listFileName).suffix());
+              QFile workerListFile(workerListFileName);
+              if ( ! workerListFile.open(QFile::WriteOnly | QFile::Text)) {
+                  emit gui->messageSig(LOG_ERROR,QObject::tr("Failed to create LDView %1 worker list file %2.")
+                                       .arg(render, workerListFileName));
+                  for (const QString &createdListFileName : workerListFileNames)
+                      QFile::remove(createdListFileName);
+                  return -1;
+              }
+              workerListFileNames << workerListFileName;
+              QTextStream out(&workerListFile);
+              for (const QString &line : listLines.mid(worker * chunk, chunk))
+                  out << line << lpub_endl;
+              workerListFile.close();
+
+              QStringList workerArgs = arguments;
+              workerArgs.replace(listArgumentIndex, QString("%1=%2").arg(listKey, workerListFileName));
+              workerArguments << workerArgs;
+          }
+          emit gui->messageSig(LOG_INFO,QObject::tr("LDView %1 render list of %2 entries split across %3 worker processes.")
+                               .arg(render).arg(listLines.size()).arg(workerArguments.size()));
+      }
+  }
+
+  QList<QProcess *> ldviewWorkers;
+  QStringList ldviewErrorFiles;
+  for (int worker = 0; worker < workerArguments.size(); worker++) {
+      const QString workerSfx = workerArguments.size() > 1 ? QString("-%1").arg(worker) : QString();
+      const QString errorFile = QDir::currentPath() + QDir::separator() + "stderr-ldview" + workerSfx;
+      QProcess *ldview = new QProcess;
+      ldview->setEnvironment(ldviewEnvVars);
+      ldview->setWorkingDirectory(QDir::currentPath() + QDir::separator() +  Paths::tmpDir);
+      ldview->setStandardErrorFile(errorFile);
+      ldview->setStandardOutputFile(QDir::currentPath() + QDir::separator() + "stdout-ldview" + workerSfx);
+      ldview->start(Preferences::ldviewExe,workerArguments.at(worker));
+      ldviewWorkers << ldview;
+      ldviewErrorFiles << errorFile;
+  }
+
+  int rc = 0;
+  for (int worker = 0; worker < ldviewWorkers.size(); worker++) {
+      QProcess *ldview = ldviewWorkers.at(worker);
+      if ( ! ldview->waitForFinished(rendererTimeout())) {
+          if (ldview->exitCode() != 0 || 1) {
+              // stop a worker that is still rendering so it does not outlive the call
+              if (ldview->state() != QProcess::NotRunning) {
+                  ldview->kill();
+                  ldview->waitForFinished(3000);
+              }
+              // standard error is redirected to the worker log file
+              QString result;
+              QFile errorFile(ldviewErrorFiles.at(worker));
+              if (errorFile.open(QFile::ReadOnly | QFile::Text)) {
+                  result = QString::fromLocal8Bit(errorFile.readAll()).trimmed();
+                  errorFile.close();
+              }
+              emit gui->messageSig(LOG_ERROR,QObject::tr("LDView %1 %2 render failed with code %3 %4 (see %5)")
+                                   .arg(useLDViewSCall() ? "(SingleCall)" : "(Default)")
+                                   .arg(render)
+                                   .arg(ldview->exitCode())
+                                   .arg(result, QFileInfo(errorFile).fileName()));
+              rc = -1;
+            }
+        }
+  }
+  qDeleteAll(ldviewWorkers);
+
+  for (const QString &workerListFileName : workerListFileNames)
+      QFile::remove(workerListFileName);
+
+  if (rc)
+      return rc;
+
   if (!usingInputFileList) {
       QFile outputImageFile(arguments.last());
       if (! outputImageFile.exists()) {
@@ -4314,8 +4402,7 @@ bool Render::isSingleSubfile(const QStringList &partLines)
         singleSubfile = lpub->ldrawFile.isSingleSubfileLine(partLines.first());
     } else {
         int partCount = 0;
-        static QRegularExpression rx;
-        rx.setPattern("^[1-5]\\s+");
+        static const QRegularExpression rx("^[1-5]\\s+");
         for (int i = 0; i < partLines.count(); i++) {
             const QString &partLine = partLines[i];
             if (!partLine.contains(rx))
@@ -118,7 +118,14 @@ public:
                                      const QString &modelName,
                                      FloatPairMeta &ca,
                                      int option,
-                                     int imageType);
+                                     int imageType,
+                                     const QStringList *preRotatedParts = nullptr);
+  static QStringList     rotatePartsForLdr(const QString &addLine, // RotateParts #2 rotation only - no LDrawFile access
+                                     RotStepMeta &rotStep,
+                                     const QStringList &parts,
+                                     FloatPairMeta &ca,
+                                     int option,
+                                     bool singleSubfile);
   static int             rotateParts(const QString &addLine,     // RotateParts #3 - 6 parms
                                      RotStepMeta &rotStep,
                                      QStringList &parts,
@@ -193,7 +193,31 @@ int Render::rotatePartsRD(
     return rotateParts(addLine, rotStepMeta, parts, ldrName, QString(), cameraAngles, DT_LDV_FUNCTION, imageType);
 }
 
+// RotateParts #2 rotation only - rotates a copy of the parts for the ldr file. This does
+// not read or write LDrawFile content so it can run while the Visual Editor entry is built,
+// singleSubfile is the isSingleSubfile(parts) result as that check reads LDrawFile
+QStringList Render::rotatePartsForLdr(
+          const QString     &addLine,
+          RotStepMeta       &rotStep,
+          const QStringList &parts,
+          FloatPairMeta     &ca,
+          int                option,
+          bool               singleSubfile)
+{
+  bool ldvFunction     = option == DT_LDV_FUNCTION || Gui::m_partListCSIFile;
+  bool nativeRenderer  = option == DT_MODEL_COVER_PAGE_PREVIEW || (Preferences::preferredRenderer == RENDERER_NATIVE && !ldvFunction);
+
+  QStringList rotatedParts = parts;
+
+  // use RotateParts #3 - do not apply camera angles for native renderer
+  if (!nativeRenderer || (nativeRenderer && !singleSubfile))
+      rotateParts(addLine,rotStep,rotatedParts,ca,!nativeRenderer);
+
+  return rotatedParts;
+}
+
 // RotateParts #2 - 8 parms - generates an ldr file (never called by pli type)
+// preRotatedParts, when set, is the result of rotatePartsForLdr for the same parts
 int Render::rotateParts(
           const QString     &addLine,
           RotStepMeta       &rotStep,
@@ -202,7 +226,8 @@ int Render::rotateParts(
           const QString     &modelName,
           FloatPairMeta     &ca,
           int                option,
-          int                type)
+          int                type,
+          const QStringList *preRotatedParts)
 {
   bool ldvFunction     = option == DT_LDV_FUNCTION || Gui::m_partListCSIFile;
   bool doFadeStep      = (Preferences::enableFadeSteps || lpub->page.meta.LPub.fadeSteps.setup.value());
@@ -211,11 +236,7 @@ int Render::rotateParts(
   bool singleSubfile   = isSingleSubfile(parts);
   Options::Mt imageType = static_cast<Options::Mt>(type);
 
-  QStringList rotatedParts = parts;
-
-  // use RotateParts #3 - do not apply camera angles for native renderer
-  if (!nativeRenderer || (nativeRenderer && !singleSubfile))
-      rotateParts(addLine,rotStep,rotatedParts,ca,!nativeRenderer);
+  QStringList rotatedParts = preRotatedParts ? *preRotatedParts : rotatePartsForLdr(addLine,rotStep,parts,ca,option,singleSubfile);
 
   QFile file(ldrName);
   if ( ! file.open(QFile::WriteOnly | QFile::Text)) {
@@ -267,6 +288,10 @@ int Render::rotateParts(
   }
   file.close();
 
+  // Hand the content to the Native renderer in memory during an export
+  if (lpub->IsNativeRenderSession())
+      lpub->SetNativeRenderContent(ldrName, nativeRenderer && !ldvFunction ? rotatedParts : QStringList());
+
   return 0;
 }
 
@@ -41,6 +41,7 @@
 #include "numberitem.h"
 #include "resolution.h"
 #include "dependencies.h"
+#include "imagecache.h"
 #include "paths.h"
 #include "ldrawfiles.h"
 #include "lc_application.h"
@@ -374,17 +375,55 @@ int Step::createCsi(
           return HitAbortProcess;
   }
 
-  // Check if png file date modified is older than model file (on the stack) date modified
+  // Content key - the part list, referenced submodel content and every value that impacts the image
+  StudStyleMeta* cssm = meta.LPub.studStyle.value() ? &meta.LPub.studStyle : &csiStepMeta.studStyle;
+  AutoEdgeColorMeta* caecm = meta.LPub.autoEdgeColor.enable.value() ? &meta.LPub.autoEdgeColor : &csiStepMeta.autoEdgeColor;
+  HighContrastColorMeta* chccm = meta.LPub.studStyle.value() ? &meta.LPub.highContrast : &csiStepMeta.highContrast;
+  QStringList cacheParameters = QStringList()
+          << QString::number(Preferences::preferredRenderer)
+          << QString::number(nType)
+          << orient
+          << keyPart2.section('_', 1) // exclude the step number
+          << QString::number(double(camDistance))
+          << QString::number(csiStepMeta.isOrtho.value())
+          << csiStepMeta.cameraName.value()
+          << QString("%1_%2_%3").arg(double(csiStepMeta.upvector.x())).arg(double(csiStepMeta.upvector.y())).arg(double(csiStepMeta.upvector.z()))
+          << QString("%1_%2_%3").arg(double(csiStepMeta.position.x())).arg(double(csiStepMeta.position.y())).arg(double(csiStepMeta.position.z()))
+          << QString("%1_%2").arg(double(csiStepMeta.cameraZNear.value())).arg(double(csiStepMeta.cameraZFar.value()))
+          << ldviewParms.value() << ldgliteParms.value() << povrayParms.value()
+          << QString("%1_%2_%3_%4").arg(cssm->value()).arg(caecm->enable.value()).arg(double(caecm->contrast.value())).arg(double(caecm->saturation.value()))
+          << QString::number(double(chccm->lightDarkIndex.value()))
+          << QString("%1_%2_%3_%4").arg(csiStepMeta.fadeSteps.enable.value()).arg(csiStepMeta.highlightStep.enable.value())
+                                   .arg(Preferences::validFadeStepsColour, Preferences::highlightStepColour);
+  if (Preferences::preferredRenderer == RENDERER_POVRAY) {
+      LightMeta lm;
+      for (LightData &ld : lightList) {
+          lm.setValue(ld);
+          cacheParameters << lm.getPOVLightString();
+      }
+  }
+  QByteArray csiCacheKey = ImageCache::key(csiParts, cacheParameters);
+
+  // Check if png file was rendered from the same content key. Images not yet
+  // in the cache index fall back to the model file (on the stack) date modified check
   csiOutOfDate = false;
+  bool csiShared = false;
 
   QFile csi(pngName);
   csiExist = csi.exists();
   if (csiExist) {
-      QString parentModelName = parent->modelName();
-      QDateTime lastModified = QFileInfo(pngName).lastModified();
-      QStringList parsedStack = submodelStack();
-      parsedStack << parentModelName;
-      if ( ! isOlder(parsedStack,lastModified)) {
+      ImageCache::State cacheState = ImageCache::state(pngName, csiCacheKey);
+      if (cacheState == ImageCache::Unknown) {
+          QString parentModelName = parent->modelName();
+          QDateTime lastModified = QFileInfo(pngName).lastModified();
+          QStringList parsedStack = submodelStack();
+          parsedStack << parentModelName;
+          if (isOlder(parsedStack,lastModified))
+              ImageCache::insert(pngName, csiCacheKey);
+          else
+              cacheState = ImageCache::Stale;
+      }
+      if (cacheState == ImageCache::Stale) {
           csiOutOfDate = true;
           emit gui->messageSig(LOG_DEBUG,QString("CSI image out of date %1.").arg(QFileInfo(pngName).fileName()));
           if (! csi.remove()) {
@@ -393,6 +432,13 @@ int Step::createCsi(
       }
   }
 
+  // Use an existing image rendered from identical content - e.g. the same step in another submodel
+  if (!csiExist || csiOutOfDate) {
+      csiShared = ImageCache::share(pngName, csiCacheKey);
+      if (csiShared)
+          emit gui->messageSig(LOG_DEBUG,QString("CSI image %1 shared from image cache.").arg(QFileInfo(pngName).fileName()));
+  }
+
   // populate viewerStepKey variable
   viewerStepKey = QString("%1;%2;%3%4")
                           .arg(top.modelIndex)
@@ -421,6 +467,40 @@ int Step::createCsi(
 
   QElapsedTimer timer;
 
+  // Start the renderer CSI ldr file - the RotateParts #2 part rotation works on its own copy
+  // of the step values so it runs on the thread pool while the Visual Editor entry below is
+  // generated. The ldr file itself is written after the Visual Editor entry as it uses LDrawFile
+  bool renderCsi = (!csiExist || csiOutOfDate) && !csiShared;
+  bool renderLdrPending = false;
+  QFuture<QStringList> rotateLdrFuture;
+
+  if (renderCsi) {
+     // populate ldr file name
+     ldrName = QDir::toNativeSeparators(QString("%1/%2.ldr").arg(csiLdrFilePath, key));
+
+     // rotate parts and create the CSI file for LDView single call and Native renderering
+     if (Render::useLDViewSCall() || nativeRenderer) {
+
+         if (nativeRenderer)
+            ldrName = csiLdrFile;
+
+         // set rotated parts - the worker gets its own copy of every input so the
+         // Visual Editor entry below can use the step values at the same time
+         const bool singleSubfile = renderer->isSingleSubfile(csiParts);
+         rotateLdrFuture = QtConcurrent::run([addLine, futureRotStep = rotStepMeta, futureParts = csiParts,
+                                              futureCameraAngles = cameraAngles, singleSubfile] () mutable {
+             return Render::rotatePartsForLdr(
+                      addLine,
+                      futureRotStep,
+                      futureParts,
+                      futureCameraAngles,
+                      DT_DEFAULT,
+                      singleSubfile);
+         });
+         renderLdrPending = true;
+     }
+  }
+
   // Generate Visual Editor CSI entry - this must come before 'Generate the renderer CSI file'
   // as we are using the entered key to render the CSI
   if (!Gui::exportingObjects() || nativeRenderer) {
@@ -652,48 +732,38 @@ int Step::createCsi(
   Q_UNUSED(ldrawFile)
 #endif
 
+  // Generate the renderer CSI ldr file from the parts rotated on the thread pool
+  if (renderLdrPending) {
+     const QStringList rotatedParts = rotateLdrFuture.result();
+     // RotateParts #2 - 8 parms, Camera angles not applied but ROTSTEP applied to rotated parts for Native renderer - this rotateParts routine generates an ldr file
+     if (!rc && renderer->rotateParts(
+                  addLine,
+                  rotStepMeta,
+                  csiParts,
+                  ldrName,
+                  top.modelName,
+                  cameraAngles,
+                  DT_DEFAULT,
+                  Options::CSI,
+                  &rotatedParts) != 0) {
+         emit gui->messageSig(LOG_ERROR,QString("Failed to create and rotate CSI ldr file: %1.").arg(ldrName));
+         pngName = QString(":/resources/missingimage.png");
+         rc = -1;
+     }
+  }
+
+  if (rc)
+     ldrName.clear();
+
   // Generate the renderer CSI file
 
-  if (!rc && (!csiExist || csiOutOfDate)) {
+  if (!rc && renderCsi) {
 
      timer.start();
 
      // this is initialized to true but set to false on csiItem mouseReleaseEvent so reset here
      updateViewer = true;
 
-     // populate ldr file name
-     ldrName = QDir::toNativeSeparators(QString("%1/%2.ldr").arg(csiLdrFilePath, key));
-
-     // rotate parts and create the CSI file for LDView single call and Native renderering
-     if (Render::useLDViewSCall() || nativeRenderer) {
-
-         if (nativeRenderer)
-            ldrName = csiLdrFile;
-
-         // set rotated parts
-         QFuture<int> future = QtConcurrent::run([&] () {
-             int rcf = 0;
-             QStringList futureParts = csiParts;
-             // RotateParts #2 - 8 parms, Camera angles not applied but ROTSTEP applied to rotated parts for Native renderer - this rotateParts routine generates an ldr file
-             if ((rcf = renderer->rotateParts(
-                      addLine,
-                      rotStepMeta,
-                      futureParts,
-                      ldrName,
-                      top.modelName,
-                      cameraAngles,
-                      DT_DEFAULT,
-                      Options::CSI)) != 0) {
-                 emit gui->messageSig(LOG_ERROR,QString("Failed to create and rotate CSI ldr file: %1.").arg(ldrName));
-                 pngName = QString(":/resources/missingimage.png");
-                 rcf = -1;
-             }
-             return rcf;
-         });
-
-         rc = future.result();
-     }
-
      bool showStatus = Gui::m_partListCSIFile;
 
      if (!rc && !Render::useLDViewSCall() && ! Gui::m_partListCSIFile) {
@@ -721,8 +791,7 @@ int Step::createCsi(
             if (lightList.size()) {
                 QStringList pl;
                 if (!meta.LPub.assem.ldviewParms.value().isEmpty()) {
-                    static QRegularExpression quotedRx;
-                    quotedRx.setPattern("\"|'");
+                    static const QRegularExpression quotedRx("\"|'");
                     pl = meta.LPub.assem.ldviewParms.value().split(' ');
                     for (int i = 0; i < pl.size(); i++) {
                         if (QString(pl.at(i)).contains(quotedRx))
@@ -769,6 +838,15 @@ int Step::createCsi(
          //rc = RenderFuture.result();
      }
 
+     // record the content key of the rendered image - LDView single call
+     // images are recorded when the page batch render has produced them
+     if (!rc && !Gui::m_partListCSIFile) {
+         if (Render::useLDViewSCall())
+             ImageCache::defer(ldrName, pngName, csiCacheKey);
+         else
+             ImageCache::insert(pngName, csiCacheKey);
+     }
+
      if (!rc && showStatus) {
          emit gui->messageSig(LOG_INFO,
                                   QString("%1 CSI render call took %2 "
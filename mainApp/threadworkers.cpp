@@ -2216,6 +2216,8 @@ int CountPageWorker::countPage(
                          opts.flags.countInstances,
                          true/*countPage*/);
 
+  Gui::addPageCountRendered(opts);
+
   Rc rc;
   QStringList bfxParts;
 
@@ -2340,7 +2342,7 @@ int CountPageWorker::countPage(
 
               QStringList tokens;
 
-              split(line,tokens);
+              ldrawFile->readLineTokens(opts.current.modelName,opts.current.lineNumber,line,tokens);
 
               if (tokens.size() == 15) {
 
@@ -2455,7 +2457,14 @@ int CountPageWorker::countPage(
                                               opts.renderModelColour,
                                               opts.current.modelName /*renderParentModel*/);
 
+                                  // record the submodel instance so a later edit can count it again on its own
+                                  const int spanIndex = Gui::pageCountRecording ? Gui::openPageCountSpan(meta, modelOpts, line) : -1;
+
                                   const TraverseRc drc = static_cast<TraverseRc>(countPage(meta, ldrawFile, modelOpts, line));
+
+                                  if (spanIndex > -1)
+                                      Gui::closePageCountSpan(spanIndex, meta, modelOpts.pageNum);
+
                                   if (drc == HitAbortProcess)
                                       return static_cast<int>(drc);
 
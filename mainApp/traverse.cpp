@@ -48,6 +48,7 @@
 #include "reserve.h"
 #include "step.h"
 #include "paths.h"
+#include "imagecache.h"
 #include "metaitem.h"
 #include "pointer.h"
 #include "pagepointer.h"
@@ -118,6 +119,8 @@ void Gui::remove_group(
 
   auto parseGroupMeta = [&line](Rc &grpType)
   {
+    if (!Meta::maybeGroupMeta(line))
+      return QString();
     QHash<Rc, QRegularExpression>::const_iterator i = groupRegExMap.constBegin();
     QRegularExpressionMatch match;
     while (i != groupRegExMap.constEnd()) {
@@ -782,7 +785,7 @@ int Gui::drawPage(
         /* read the line from the ldrawFile repository */
 
             line = lpub->ldrawFile.readLine(opts.current.modelName,opts.current.lineNumber);
-            split(line,tokens);
+            lpub->ldrawFile.readLineTokens(opts.current.modelName,opts.current.lineNumber,line,tokens);
         } // If we hit end of file, note end of step or if not, get the next LDraw line
 
         // STEP - Process part type
@@ -2240,10 +2243,13 @@ int Gui::drawPage(
 
                         // renderer parms are added to csiKeys in createCsi call
 
-                        if (static_cast<TraverseRc>(renderer->renderCsi(empty,opts.ldrStepFiles,opts.csiKeys,empty,/*steps->meta*/steps->groupStepMeta)) != HitNothing) {
+                        const bool rendered = static_cast<TraverseRc>(renderer->renderCsi(empty,opts.ldrStepFiles,opts.csiKeys,empty,/*steps->meta*/steps->groupStepMeta)) == HitNothing;
+                        if (!rendered) {
                             emit gui->messageSig(LOG_ERROR, tr("Render CSI images failed."));
                         }
 
+                        ImageCache::commit(opts.ldrStepFiles, rendered && !Gui::abortProcess());
+
                         emit gui->messageSig(LOG_INFO,
                                         tr("%1 CSI (Single Call) render took "
                                            "%2 milliseconds to render %3 [Step %4] %5 "
@@ -2909,6 +2915,8 @@ int Gui::drawPage(
                                 if (returnValue != HitNothing)
                                     emit gui->messageSig(LOG_ERROR, tr("Render CSI images failed."));
 
+                                ImageCache::commit(opts.ldrStepFiles, returnValue == HitNothing && !Gui::abortProcess());
+
                                 emit gui->messageSig(LOG_INFO,
                                                 tr("%1 CSI (Single Call) render took "
                                                    "%2 milliseconds to render %3 [Step %4] %5 for %6 "
@@ -3425,7 +3433,7 @@ int Gui::findPage(
 
         switch (line.toLatin1()[0]) {
         case '1':
-            split(line,tokens);
+            lpub->ldrawFile.readLineTokens(opts.current.modelName,opts.current.lineNumber,line,tokens);
 
             // inherit colour number if material colour
             if (tokens.size() > 2) {
@@ -3446,9 +3454,7 @@ int Gui::findPage(
                 }
                 Gui::lastStepPageNum = opts.pageNum;
 
-                QStringList tokens;
-
-                split(line,tokens);
+                // line was rebuilt from tokens, so tokens are already split
 
                 if (tokens.size() == 15) {
 
@@ -5021,6 +5027,14 @@ void Gui::countPages()
       if (Gui::buildModJumpForward) {
           fpFlags.parseBuildMods = true;
           message = tr("BuildMod Next parsing from countPage for jump to page %1...").arg(Gui::saveDisplayPageNum);
+          pageCountRevisions.clear();
+      } else {
+          pageCountRevisions = lpub->ldrawFile.getSubmodelRevisions();
+          if (restorePageCount()) {
+              pageCountRevisions.clear();
+              pagesCounted();
+              return;
+          }
       }
 
       emit gui->messageSig(LOG_TRACE, message);
@@ -5044,17 +5058,531 @@ void Gui::countPages()
 
       LDrawFile::_currentLevels.clear();
 
+      // record the submodel instances of a complete count from the top
+      Gui::pageCountSpans.clear();
+      Gui::pageCountSpanIndexes.clear();
+      Gui::pageCountRendered.clear();
+      Gui::pageCountRecording = !pageCountRevisions.isEmpty() && !Gui::exporting() && !Gui::ContinuousPage();
+
 #if QT_VERSION >= QT_VERSION_CHECK(6,0,0)
       QFuture<int> future = QtConcurrent::run(CountPageWorker::countPage, &meta, &lpub->ldrawFile, std::ref(opts), empty);
 #else
       QFuture<int> future = QtConcurrent::run(CountPageWorker::countPage, &meta, &lpub->ldrawFile, opts, empty);
 #endif
-      future.waitForFinished();
+      const TraverseRc crc = static_cast<TraverseRc>(future.result());
+      Gui::pageCountRecording = false;
+      if (crc != HitAbortProcess)
+          savePageCount();
+      Gui::pageCountSpans.clear();
+      Gui::pageCountSpanIndexes.clear();
 
       pagesCounted();
    }
 }
 
+/*
+ * Open and close the span of a submodel instance walked by countPage.
+ * Called from the count worker while the GUI thread waits on the count.
+ */
+
+int Gui::openPageCountSpan(Meta *meta, FindPageOptions &opts, const QString &addLine)
+{
+  PageCountSpan span;
+  span.current           = opts.current;
+  span.addLine           = addLine;
+  span.flags             = opts.flags;
+  span.pageDisplayed     = opts.pageDisplayed;
+  span.displayModel      = opts.displayModel;
+  span.updateViewer      = opts.updateViewer;
+  span.isMirrored        = opts.isMirrored;
+  span.printing          = opts.printing;
+  span.stepNumber        = opts.stepNumber;
+  span.contStepNumber    = opts.contStepNumber;
+  span.groupStepNumber   = opts.groupStepNumber;
+  span.renderModelColour = opts.renderModelColour;
+  span.renderParentModel = opts.renderParentModel;
+  span.startPage         = opts.pageNum;
+  span.startTopOfPages   = Gui::topOfPages.size();
+  span.firstStepPageNum  = Gui::firstStepPageNum;
+  span.lastStepPageNum   = Gui::lastStepPageNum;
+
+  // only a submodel walked once is counted again on its own, so the meta is
+  // copied for its first instance and released when it is walked again
+  QString const modelName = opts.current.modelName.toLower();
+  QHash<QString, int>::const_iterator first = Gui::pageCountSpanIndexes.constFind(modelName);
+  if (first == Gui::pageCountSpanIndexes.constEnd()) {
+      Gui::pageCountSpanIndexes.insert(modelName, Gui::pageCountSpans.size());
+      span.meta = QSharedPointer<Meta>(new Meta(*meta));
+  } else {
+      Gui::pageCountSpans[first.value()].meta.reset();
+  }
+
+  Gui::pageCountSpans.append(span);
+
+  return Gui::pageCountSpans.size() - 1;
+}
+
+void Gui::closePageCountSpan(int index, Meta *meta, int pageNum)
+{
+  PageCountSpan &span = Gui::pageCountSpans[index];
+  span.endPage              = pageNum;
+  span.endTopOfPages        = Gui::topOfPages.size();
+  span.exitFirstStepPageNum = Gui::firstStepPageNum;
+  span.exitLastStepPageNum  = Gui::lastStepPageNum;
+  span.exitCountInstance    = meta->LPub.countInstance.value();
+  span.exitCalloutBegin     = meta->LPub.callout.begin.value();
+  span.exitParseNoStep      = meta->LPub.parseNoStep.value();
+  span.nested               = Gui::pageCountSpans.size() > index + 1;
+
+  // only leaf submodels are counted again on their own
+  if (span.nested)
+      span.meta.reset();
+}
+
+void Gui::addPageCountRendered(FindPageOptions &opts)
+{
+  PageCountRendered rendered;
+  rendered.modelName         = opts.current.modelName;
+  rendered.modelColour       = opts.renderModelColour;
+  rendered.renderParentModel = opts.renderParentModel;
+  rendered.mirrored          = opts.isMirrored;
+  rendered.stepNumber        = opts.stepNumber;
+  rendered.countInstance     = opts.flags.countInstances;
+
+  Gui::pageCountRendered.append(rendered);
+}
+
+/*
+ * Record the registers of a complete page count against the submodel
+ * revisions captured when the count started. Counts that parse build
+ * mods for a page jump, or that run while exporting, stop early or
+ * update export page sizes so they are not recorded.
+ */
+
+void Gui::savePageCount()
+{
+  const QList<PageCountSpan> spans = Gui::pageCountSpans;
+  Gui::pageCountSpans.clear();
+  Gui::pageCountSpanIndexes.clear();
+  const QList<PageCountRendered> rendered = Gui::pageCountRendered;
+  Gui::pageCountRendered.clear();
+
+  if (pageCountRevisions.isEmpty())
+      return;
+
+  if (Gui::buildModJumpForward || Gui::exporting() || Gui::ContinuousPage() || Gui::abortProcess()) {
+      pageCountRevisions.clear();
+      return;
+  }
+
+  const QHash<QString, int> previousRevisions = pageCountSummary.revisions;
+  const int previousMaxPages = pageCountSummary.maxPages;
+
+  pageCountSummary.revisions        = pageCountRevisions;
+  pageCountSummary.topOfPages       = Gui::topOfPages;
+  pageCountSummary.current          = current;
+  pageCountSummary.maxPages         = Gui::maxPages;
+  pageCountSummary.stepPageNum      = Gui::stepPageNum;
+  pageCountSummary.firstStepPageNum = Gui::firstStepPageNum;
+  pageCountSummary.lastStepPageNum  = Gui::lastStepPageNum;
+  pageCountSummary.pa               = Gui::pa;
+  pageCountSummary.sa               = Gui::sa;
+  pageCountSummary.buildModEnabled  = Preferences::buildModEnabled;
+  pageCountSummary.startPageNumbers.clear();
+  for (const QString &modelName : pageCountRevisions.keys())
+      pageCountSummary.startPageNumbers.insert(modelName, lpub->ldrawFile.getModelStartPageNumber(modelName));
+  pageCountSummary.spans            = spans;
+  pageCountSummary.rendered         = rendered;
+  pageCountSummary.fileName         = Gui::getCurFile();
+
+  // only save the summary with the model when the count has changed
+  const bool unchanged = pageCountSummary.valid &&
+                         pageCountSummary.maxPages == previousMaxPages &&
+                         pageCountSummary.revisions == previousRevisions;
+  pageCountSummary.valid            = true;
+
+  pageCountRevisions.clear();
+
+  if (!unchanged)
+      writePageCount();
+}
+
+/*
+ * Restore the last page count when no submodel changed since it was
+ * recorded. Changed leaf submodels are counted again from their span
+ * and the pages after them shifted. Otherwise the model is counted
+ * again from the top.
+ */
+
+bool Gui::restorePageCount()
+{
+  if (Gui::exporting() || Gui::ContinuousPage())
+      return false;
+
+  // the count walk registers and renders build modifications - always count them
+  if (Preferences::buildModEnabled && lpub->ldrawFile.buildModsCount()) {
+      pageCountSummary.valid = false;
+      return false;
+  }
+
+  // first count after the model is opened - try the page count saved with the model
+  if (!pageCountSummary.valid && pageCountSummary.fileName != Gui::getCurFile())
+      readPageCount();
+
+  if (!pageCountSummary.valid)
+      return false;
+
+  if (pageCountSummary.pa != Gui::pa ||
+      pageCountSummary.sa != Gui::sa ||
+      pageCountSummary.buildModEnabled != Preferences::buildModEnabled) {
+      pageCountSummary.valid = false;
+      return false;
+  }
+
+  QStringList changed;
+  for (QHash<QString, int>::const_iterator i = pageCountRevisions.constBegin(); i != pageCountRevisions.constEnd(); ++i)
+      if (pageCountSummary.revisions.value(i.key(), -1) != i.value())
+          changed << i.key();
+  for (const QString &modelName : pageCountSummary.revisions.keys())
+      if (!pageCountRevisions.contains(modelName))
+          changed << modelName;
+
+  if (!changed.isEmpty()) {
+      emit gui->messageSig(LOG_TRACE, tr("Counting pages for %1 changed %2: %3")
+                                         .arg(changed.size())
+                                         .arg(changed.size() == 1 ? tr("submodel") : tr("submodels"))
+                                         .arg(changed.join(", ")));
+      if (!recountPageCount(changed)) {
+          pageCountSummary.valid = false;
+          return false;
+      }
+  }
+
+  Gui::topOfPages       = pageCountSummary.topOfPages;
+  current               = pageCountSummary.current;
+  Gui::maxPages         = pageCountSummary.maxPages;
+  Gui::stepPageNum      = pageCountSummary.stepPageNum;
+  Gui::firstStepPageNum = pageCountSummary.firstStepPageNum;
+  Gui::lastStepPageNum  = pageCountSummary.lastStepPageNum;
+  for (QHash<QString, int>::const_iterator i = pageCountSummary.startPageNumbers.constBegin(); i != pageCountSummary.startPageNumbers.constEnd(); ++i)
+      lpub->ldrawFile.setModelStartPageNumber(i.key(), i.value());
+  for (const PageCountRendered &rendered : pageCountSummary.rendered)
+      lpub->ldrawFile.setRendered(rendered.modelName,
+                                  rendered.modelColour,
+                                  rendered.renderParentModel,
+                                  rendered.mirrored,
+                                  rendered.stepNumber,
+                                  rendered.countInstance,
+                                  true/*countPage*/);
+
+  if (changed.isEmpty())
+      emit gui->messageSig(LOG_TRACE, tr("Page count restored - %1 pages, no submodel changes.").arg(Gui::maxPages - 1));
+  else
+      emit gui->messageSig(LOG_TRACE, tr("Page count updated - %1 pages, counted %2 changed %3.")
+                                         .arg(Gui::maxPages - 1)
+                                         .arg(changed.size())
+                                         .arg(changed.size() == 1 ? tr("submodel") : tr("submodels")));
+
+  return true;
+}
+
+/*
+ * Count the changed submodels again from the spans of the last complete
+ * page count and shift the pages after each span by the page difference.
+ * A submodel is only counted on its own when it is a leaf walked once,
+ * references no submodel, include file or build modification and leaves
+ * the same count settings to its parent. Returns false when the model
+ * must be counted from the top.
+ */
+
+bool Gui::recountPageCount(const QStringList &changed)
+{
+  if (pageCountSummary.spans.isEmpty() || Preferences::buildModEnabled != pageCountSummary.buildModEnabled)
+      return false;
+
+  if (Preferences::buildModEnabled && lpub->ldrawFile.buildModsCount())
+      return false;
+
+  const QString topLevelFile = lpub->ldrawFile.topLevelFile().toLower();
+
+  // the spans of the changed submodels in walk order
+  QList<int> changedSpans;
+  for (const QString &modelName : changed) {
+      // added or removed submodels change what the unchanged parents reference
+      if (modelName == topLevelFile ||
+          !pageCountSummary.revisions.contains(modelName) ||
+          !pageCountRevisions.contains(modelName) ||
+          lpub->ldrawFile.isIncludeFile(modelName))
+          return false;
+
+      int spanIndex = -1;
+      for (int i = 0; i < pageCountSummary.spans.size(); i++) {
+          if (pageCountSummary.spans.at(i).current.modelName.toLower() == modelName) {
+              if (spanIndex > -1)
+                  return false;
+              spanIndex = i;
+          }
+      }
+
+      // not walked by the page count - its content does not change the count
+      if (spanIndex < 0)
+          continue;
+
+      const PageCountSpan &span = pageCountSummary.spans.at(spanIndex);
+      if (span.nested || span.meta.isNull())
+          return false;
+
+      const int numLines = lpub->ldrawFile.size(modelName);
+      for (int lineNumber = 0; lineNumber < numLines; lineNumber++) {
+          QString line = lpub->ldrawFile.readLine(modelName, lineNumber).trimmed();
+          if (line.startsWith("0 GHOST "))
+              line = line.mid(8).trimmed();
+          if (line.startsWith('1')) {
+              QStringList tokens;
+              split(line, tokens);
+              if (tokens.size() == 15 && lpub->ldrawFile.isSubmodel(tokens.last()))
+                  return false;
+          } else if (line.startsWith('0') && (line.contains(" INCLUDE ") || line.contains(" BUILD_MOD "))) {
+              return false;
+          }
+      }
+
+      changedSpans << spanIndex;
+  }
+
+  std::sort(changedSpans.begin(), changedSpans.end());
+
+  for (const int spanIndex : changedSpans) {
+      PageCountSpan span = pageCountSummary.spans.at(spanIndex);
+
+      Meta meta(*span.meta);
+      Where current2 = span.current;
+      int pageNum = span.startPage;
+      PageSizeData pageSize;
+      FindPageFlags flags = span.flags;
+      QList<SubmodelStack> modelStack;
+
+      FindPageOptions opts(
+                  pageNum,
+                  current2,
+                  pageSize,
+                  flags,
+                  modelStack,
+                  span.pageDisplayed,
+                  span.displayModel,
+                  span.updateViewer,
+                  span.isMirrored,
+                  span.printing,
+                  span.stepNumber,
+                  span.contStepNumber,
+                  span.groupStepNumber,
+                  span.renderModelColour,
+                  span.renderParentModel);
+
+      Gui::topOfPages       = pageCountSummary.topOfPages.mid(0, span.startTopOfPages);
+      Gui::firstStepPageNum = span.firstStepPageNum;
+      Gui::lastStepPageNum  = span.lastStepPageNum;
+
+      LDrawFile::_currentLevels.clear();
+
+#if QT_VERSION >= QT_VERSION_CHECK(6,0,0)
+      QFuture<int> future = QtConcurrent::run(CountPageWorker::countPage, &meta, &lpub->ldrawFile, std::ref(opts), span.addLine);
+#else
+      QFuture<int> future = QtConcurrent::run(CountPageWorker::countPage, &meta, &lpub->ldrawFile, opts, span.addLine);
+#endif
+      if (static_cast<TraverseRc>(future.result()) == HitAbortProcess)
+          return false;
+
+      // settings left to the parent walk must match or the pages after the span change too
+      if (meta.LPub.countInstance.value() != span.exitCountInstance ||
+          int(meta.LPub.callout.begin.value()) != span.exitCalloutBegin ||
+          meta.LPub.parseNoStep.value() != span.exitParseNoStep)
+          return false;
+
+      const int oldEndPage = span.endPage;
+      const int oldExitFirstStepPageNum = span.exitFirstStepPageNum;
+      const int oldExitLastStepPageNum = span.exitLastStepPageNum;
+      const int newExitFirstStepPageNum = Gui::firstStepPageNum;
+      const int newExitLastStepPageNum = Gui::lastStepPageNum;
+      const int delta = pageNum - oldEndPage;
+
+      // map a first step page number recorded after the span exit
+      bool mapped = true;
+      auto firstStepPageNum = [&] (int value)
+      {
+          if (value == -1 || oldExitFirstStepPageNum == -1)
+              return value == -1 ? newExitFirstStepPageNum
+                                 : newExitFirstStepPageNum != -1 ? newExitFirstStepPageNum : value + delta;
+          if (span.firstStepPageNum != -1)
+              return value;
+          // first set inside the span - unknown when the span no longer has a step
+          mapped &= newExitFirstStepPageNum != -1;
+          return newExitFirstStepPageNum;
+      };
+
+      // map a last step page number recorded after the span exit - it only grows with the page number
+      auto lastStepPageNum = [&] (int value)
+      {
+          if (value != oldExitLastStepPageNum)
+              return value + delta;
+          if (value < oldEndPage)
+              return newExitLastStepPageNum;
+          // set at the span end page - inside the span or on the page after it
+          mapped &= newExitLastStepPageNum == value + delta;
+          return value + delta;
+      };
+
+      PageCountSummary summary = pageCountSummary;
+
+      summary.topOfPages        = Gui::topOfPages + pageCountSummary.topOfPages.mid(span.endTopOfPages);
+      summary.maxPages         += delta;
+      summary.firstStepPageNum  = firstStepPageNum(pageCountSummary.firstStepPageNum);
+      summary.lastStepPageNum   = lastStepPageNum(pageCountSummary.lastStepPageNum);
+
+      PageCountSpan &recounted = summary.spans[spanIndex];
+      recounted.endPage              = pageNum;
+      recounted.endTopOfPages        = Gui::topOfPages.size();
+      recounted.exitFirstStepPageNum = newExitFirstStepPageNum;
+      recounted.exitLastStepPageNum  = newExitLastStepPageNum;
+
+      for (int i = spanIndex + 1; i < summary.spans.size(); i++) {
+          PageCountSpan &next = summary.spans[i];
+          next.startPage            += delta;
+          next.endPage              += delta;
+          next.startTopOfPages      += delta;
+          next.endTopOfPages        += delta;
+          next.firstStepPageNum      = firstStepPageNum(next.firstStepPageNum);
+          next.lastStepPageNum       = lastStepPageNum(next.lastStepPageNum);
+          next.exitFirstStepPageNum  = firstStepPageNum(next.exitFirstStepPageNum);
+          next.exitLastStepPageNum   = lastStepPageNum(next.exitLastStepPageNum);
+      }
+
+      if (!mapped || summary.topOfPages.size() != pageCountSummary.topOfPages.size() + delta)
+          return false;
+
+      // the model start page is set by the last instance walked
+      for (const PageCountSpan &next : summary.spans)
+          summary.startPageNumbers.insert(next.current.modelName.toLower(), next.startPage);
+
+      pageCountSummary = summary;
+  }
+
+  pageCountSummary.revisions = pageCountRevisions;
+
+  writePageCount();
+
+  return true;
+}
+
+/*
+ * The page count summary is saved in the LPub3D folder of the model
+ * under the model file name. It is keyed by the digest of all submodel
+ * content so it is only used when the model is reopened unchanged.
+ */
+
+#define PAGE_COUNT_MAGIC   0x4C504331 // LPC1
+#define PAGE_COUNT_VERSION 2
+
+static QString pageCountFileName()
+{
+  return QDir::toNativeSeparators(QString("%1/%2/%3.pagecount")
+                                  .arg(QDir::currentPath(), Paths::lpubDir, QFileInfo(Gui::getCurFile()).fileName()));
+}
+
+bool Gui::readPageCount()
+{
+  pageCountSummary.fileName = Gui::getCurFile();
+
+  QFile file(pageCountFileName());
+  if (!file.open(QIODevice::ReadOnly))
+      return false;
+
+  QDataStream in(&file);
+  in.setVersion(QDataStream::Qt_5_6);
+
+  quint32 magic = 0, version = 0;
+  in >> magic >> version;
+  if (magic != PAGE_COUNT_MAGIC || version != PAGE_COUNT_VERSION)
+      return false;
+
+  QByteArray digest;
+  in >> digest;
+  if (digest != lpub->ldrawFile.getContentDigest())
+      return false;
+
+  PageCountSummary summary;
+  qint32 pages = 0;
+  in >> summary.pa >> summary.sa >> summary.buildModEnabled
+     >> summary.maxPages >> summary.stepPageNum
+     >> summary.firstStepPageNum >> summary.lastStepPageNum
+     >> summary.current.modelName >> summary.current.modelIndex >> summary.current.lineNumber
+     >> pages;
+  for (qint32 i = 0; i < pages && in.status() == QDataStream::Ok; i++) {
+      Where top;
+      in >> top.modelName >> top.modelIndex >> top.lineNumber;
+      summary.topOfPages.append(top);
+  }
+  in >> summary.startPageNumbers;
+  qint32 rendered = 0;
+  in >> rendered;
+  for (qint32 i = 0; i < rendered && in.status() == QDataStream::Ok; i++) {
+      PageCountRendered instance;
+      in >> instance.modelName >> instance.modelColour >> instance.renderParentModel
+         >> instance.mirrored >> instance.stepNumber >> instance.countInstance;
+      summary.rendered.append(instance);
+  }
+
+  if (in.status() != QDataStream::Ok)
+      return false;
+
+  summary.revisions = lpub->ldrawFile.getSubmodelRevisions();
+  summary.fileName  = Gui::getCurFile();
+  summary.valid     = true;
+  pageCountSummary  = summary;
+
+  emit gui->messageSig(LOG_TRACE, tr("Loaded page count from %1.").arg(file.fileName()));
+
+  return true;
+}
+
+void Gui::writePageCount()
+{
+  const QString fileName = pageCountFileName();
+  if (!QDir(QFileInfo(fileName).absolutePath()).exists())
+      return;
+
+  // a model with build modifications is counted every time it is opened
+  if (Preferences::buildModEnabled && lpub->ldrawFile.buildModsCount()) {
+      QFile::remove(fileName);
+      return;
+  }
+
+  QFile file(fileName);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+      emit gui->messageSig(LOG_WARNING, tr("Cannot write page count %1:<br>%2")
+                                           .arg(fileName, file.errorString()));
+      return;
+  }
+
+  QDataStream out(&file);
+  out.setVersion(QDataStream::Qt_5_6);
+
+  out << quint32(PAGE_COUNT_MAGIC) << quint32(PAGE_COUNT_VERSION)
+      << lpub->ldrawFile.getContentDigest()
+      << pageCountSummary.pa << pageCountSummary.sa << pageCountSummary.buildModEnabled
+      << pageCountSummary.maxPages << pageCountSummary.stepPageNum
+      << pageCountSummary.firstStepPageNum << pageCountSummary.lastStepPageNum
+      << pageCountSummary.current.modelName << pageCountSummary.current.modelIndex << pageCountSummary.current.lineNumber
+      << qint32(pageCountSummary.topOfPages.size());
+  for (const Where &top : pageCountSummary.topOfPages)
+      out << top.modelName << top.modelIndex << top.lineNumber;
+  out << pageCountSummary.startPageNumbers
+      << qint32(pageCountSummary.rendered.size());
+  for (const PageCountRendered &rendered : pageCountSummary.rendered)
+      out << rendered.modelName << rendered.modelColour << rendered.renderParentModel
+          << rendered.mirrored << rendered.stepNumber << rendered.countInstance;
+}
+
 void Gui::drawPage(DrawPageFlags &dpFlags)
 {
     Gui::setPageProcessRunning(PROC_DISPLAY_PAGE);
@@ -5242,6 +5770,10 @@ void Gui::drawPage(DrawPageFlags &dpFlags)
                 LDRAW_MAIN_MATERIAL_COLOUR,/*renderModelColour*/
                 "model~origin"); /*renderParentModel*/
 
+    // capture submodel revisions to record the page count when counting completes
+    pageCountRevisions = lpub->ldrawFile.getSubmodelRevisions();
+    Gui::pageCountRendered.clear();
+
     const TraverseRc frc = static_cast<TraverseRc>(findPage(lpub->meta,addLine,opts));
     if (frc == HitAbortProcess) {
         if (Gui::m_exportMode == GENERATE_BOM) {
@@ -5273,8 +5805,20 @@ void Gui::drawPage(DrawPageFlags &dpFlags)
 #endif
 //*/
 
+        // an unchanged model, e.g. reopened with its saved page count, restores the
+        // last complete page count instead of counting the pages after the display page
+        const bool countRestored = ! Gui::exporting() && ! Gui::ContinuousPage() &&
+                                   ! gui->futureWatcher.isRunning() &&
+                                   ! (Preferences::buildModEnabled && lpub->ldrawFile.buildModsCount()) &&
+                                   gui->restorePageCount();
+
         auto countPage = [&] (int modelStackCount)
         {
+            if (countRestored) {
+                gui->pageCountRevisions.clear();
+                gui->pagesCounted();
+                return static_cast<int>(HitNothing);
+            }
 #if QT_VERSION >= QT_VERSION_CHECK(6,0,0)
             QFuture<int> future = QtConcurrent::run(CountPageWorker::countPage, &lpub->meta, &lpub->ldrawFile, std::ref(opts), addLine);
 #else
@@ -5299,8 +5843,10 @@ void Gui::drawPage(DrawPageFlags &dpFlags)
 //*/
                 if (static_cast<TraverseRc>(future.result()) == HitAbortProcess)
                     return static_cast<int>(HitAbortProcess);
-                if (!modelStackCount)
+                if (!modelStackCount) {
+                    gui->savePageCount();
                     gui->pagesCounted();
+                }
             } else {
 /*
 #ifdef QT_DEBUG_MODE
@@ -5308,6 +5854,7 @@ void Gui::drawPage(DrawPageFlags &dpFlags)
         qDebug() << qPrintable(QString("DEBUG: %1").arg(message));
 #endif
 //*/
+                gui->pageCountWatched = true;
                 gui->futureWatcher.setFuture(future);
             }
             return static_cast<int>(HitNothing);
@@ -5354,7 +5901,7 @@ void Gui::drawPage(DrawPageFlags &dpFlags)
         }
 
         // if we start counting from a child submodel, load where findPage stopped in the parent model
-        for (int i = 0; i < modelStackCount && !Gui::abortProcess(); i++) {
+        for (int i = 0; i < modelStackCount && !countRestored && !Gui::abortProcess(); i++) {
             // set the step number where the submodel will be rendered
             opts.current = Where(opts.modelStack.last().modelName,
                                  gui->getSubmodelIndex(opts.modelStack.last().modelName),
@@ -5464,6 +6011,8 @@ void Gui::finishedCountingPages()
         Gui::setAbortProcess(true);
         return;
     }
+    if (pageCountWatched)
+        gui->savePageCount();
     gui->pagesCounted();
 }
 
@@ -6182,10 +6731,34 @@ int Gui::setBuildModForNextStep(
  * exchange
  */
 
-QStringList Gui::writeToTmp(const QString &fileName, const QStringList &contents, bool parseContent)
+QSharedPointer<QMutex> Gui::writeFileMutex(const QString &fileName)
 {
   QMutexLocker writeLocker(&writeMutex);
 
+  QString const key = fileName.toLower();
+  QSharedPointer<QMutex> fileMutex = writeFileMutexes.value(key);
+  if (fileMutex.isNull()) {
+      fileMutex = QSharedPointer<QMutex>(new QMutex);
+      writeFileMutexes.insert(key, fileMutex);
+  }
+
+  return fileMutex;
+}
+
+/*
+ * Submodels are parsed and written concurrently. Parse state - Meta,
+ * BuildMod levels and buffer exchange - is local to the calling thread
+ * and meta parsers only use constant regular expressions. The threads
+ * only read LDrawFile, BuildMod lookups take turns as they can set a
+ * default action. When pendingLineTypeIndexes is set, the line type indexes
+ * are returned by submodel index for the caller to store in LDrawFile.
+ */
+
+QStringList Gui::writeToTmp(const QString &fileName, const QStringList &contents, bool parseContent, QHash<int, QVector<int> > *pendingLineTypeIndexes)
+{
+  QSharedPointer<QMutex> fileMutex = writeFileMutex(fileName);
+  QMutexLocker writeLocker(fileMutex.data());
+
   QFileInfo fileInfo(fileName);
   QString const filePath = QDir::toNativeSeparators(QString("%1/%2/%3").arg(QDir::currentPath(), Paths::tmpDir, fileInfo.fileName()));
   fileInfo.setFile(filePath);
@@ -6287,6 +6860,7 @@ QStringList Gui::writeToTmp(const QString &fileName, const QStringList &contents
                           buildModIgnore = true;
                           break;
                       }
+                      writeBuildModMutex.lock();
                       buildModBottom    = getBuildModStepLineNumber(getBuildModStepIndex(topOfStep));
                       if ((buildModApplicable = i < buildModBottom)) {
                           buildModKey   = meta.LPub.buildMod.key();
@@ -6301,6 +6875,7 @@ QStringList Gui::writeToTmp(const QString &fileName, const QStringList &contents
                           else if (buildModActions.value(buildModLevel) == BuildModRemoveRc)
                               buildModIgnore = true;
                       }
+                      writeBuildModMutex.unlock();
                       break;
 
                   // Set modActionLineNum and buildModIgnore based on 'next' step buildModAction
@@ -6388,8 +6963,12 @@ QStringList Gui::writeToTmp(const QString &fileName, const QStringList &contents
           }
       }
 
-      if (!isDataFile)
-          lpub->ldrawFile.setLineTypeRelativeIndexes(topOfStep.modelIndex,lineTypeIndexes);
+      if (!isDataFile) {
+          if (pendingLineTypeIndexes)
+              pendingLineTypeIndexes->insert(topOfStep.modelIndex,lineTypeIndexes);
+          else
+              lpub->ldrawFile.setLineTypeRelativeIndexes(topOfStep.modelIndex,lineTypeIndexes);
+      }
 
       QTextStream out(&file);
       for (int i = 0; i < csiParts.size(); i++) {
@@ -6404,12 +6983,31 @@ QStringList Gui::writeToTmp(const QString &fileName, const QStringList &contents
 
 void Gui::writeToTmp()
 {
+  struct WriteToTmpFile {
+      QString fileName;
+      QString fileType;
+      QString message;
+      QString sourceFilePath;
+      bool externalFile;
+      bool displayModel;
+  };
+
+  struct WriteToTmpResult {
+      qint64 elapsed = 0;
+      QStringList smiContent;
+      QHash<int, QVector<int> > lineTypeIndexes;
+      QList<QPair<QString, QStringList> > configuredSubFiles;
+  };
+
   Gui::setPageProcessRunning(PROC_WRITE_TO_TMP);
-  QList<QFuture<void>> writeToTmpFutures;
+  ImageCache::clearDigests();
+  QList<WriteToTmpFile> writeToTmpFiles;
+  QList<QFuture<WriteToTmpResult>> writeToTmpFutures;
   QElapsedTimer writeToTmpTimer;
   writeToTmpTimer.start();
   bool progressPermInit = true;
   int writtenFiles = 0;
+  qint64 writeToTmpFileTime = 0;
   int subFileCount = lpub->ldrawFile._subFileOrder.size();
   Gui::doFadeStep  = (Preferences::enableFadeSteps || lpub->page.meta.LPub.fadeSteps.setup.value());
   Gui::doHighlightStep = (Preferences::enableHighlightStep || lpub->page.meta.LPub.highlightStep.setup.value()) && !Gui::suppressColourMeta();
@@ -6486,65 +7084,100 @@ void Gui::writeToTmp()
               QApplication::processEvents();
           }
 
-          writeToTmpFutures.append(QtConcurrent::run([message, fileName, fileType,
-              sourceFilePath, externalFile, fadeColor, displayModel, getExternalFileContent ] () {
-              if (!Gui::ContinuousPage())
-                  emit gui->messageSig(LOG_INFO, message);
+          writeToTmpFiles.append({ fileName, fileType, message, sourceFilePath, externalFile, displayModel });
+      } // ChangedSinceLastWrite
+  } // Parse _subFileOrder
 
-              if (externalFile) {
-                  QString const destinationPath = QDir::toNativeSeparators(QDir::currentPath()) + QDir::separator() + Paths::tmpDir + QDir::separator() + fileName;
-                  if (QFile::exists(destinationPath)) {
-                      QFile::remove(destinationPath);
-                  }
-                  if(!QFile::copy(sourceFilePath, destinationPath)) {
-                      emit gui->messageSig(LOG_ERROR, tr("Could not write %1file '%2' to temp folder...").arg(fileType, fileName));
-                  }
+  // The files are parsed and written concurrently. The threads only read LDrawFile,
+  // their LDrawFile updates are returned and stored here once every file is written
+  for (const WriteToTmpFile &writeFile : writeToTmpFiles) {
+      if (Gui::abortProcess())
+          break;
+
+      writeToTmpFutures.append(QtConcurrent::run([writeFile, fadeColor, getExternalFileContent] () {
+          const QString &fileName = writeFile.fileName;
+          const QString &fileType = writeFile.fileType;
+          WriteToTmpResult result;
+          QElapsedTimer writeFileTimer;
+          writeFileTimer.start();
+
+          if (!Gui::ContinuousPage())
+              emit gui->messageSig(LOG_INFO, writeFile.message);
+
+          if (writeFile.externalFile) {
+              QString const destinationPath = QDir::toNativeSeparators(QDir::currentPath()) + QDir::separator() + Paths::tmpDir + QDir::separator() + fileName;
+              if (QFile::exists(destinationPath)) {
+                  QFile::remove(destinationPath);
+              }
+              if(!QFile::copy(writeFile.sourceFilePath, destinationPath)) {
+                  emit gui->messageSig(LOG_ERROR, tr("Could not write %1file '%2' to temp folder...").arg(fileType, fileName));
               }
+          }
 
-              QStringList modelContent;
-              if ((Gui::doFadeStep || Gui::doHighlightStep) && externalFile)
-                  modelContent = getExternalFileContent(fileName);
-
-              QStringList *futureContent = new QStringList(externalFile ? modelContent : lpub->ldrawFile.contents(fileName));
-              gui->writeSmiContent(futureContent, fileName);
-              QStringList *cleanContent = new QStringList(gui->writeToTmp(fileName, *futureContent));
-
-              if (!displayModel) {
-                  QString const extension = QFileInfo(fileName).suffix().toLower();
-                  QString fadeFileNameStr, highlightFileNameStr;
-
-                  if (Gui::doFadeStep) {
-                      if (extension.isEmpty())
-                        fadeFileNameStr = QString(fileName).append(QString("%1.ldr").arg(FADE_SFX));
-                      else
-                        fadeFileNameStr = QString(fileName).replace("."+extension, QString("%1.%2").arg(FADE_SFX, extension));
-                      emit gui->messageSig(LOG_INFO, tr("Writing %1'%2' to temp folder...").arg(fileType, fadeFileNameStr));
-                      QStringList *fadeContent = new QStringList(Gui::configureModelSubFile(*cleanContent, fadeColor, FADE_PART));
-                      gui->insertConfiguredSubFile(fadeFileNameStr, *fadeContent);
-                      gui->writeToTmp(fadeFileNameStr, *fadeContent, false/*parseContent*/);
-                  }
+          QStringList modelContent;
+          if ((Gui::doFadeStep || Gui::doHighlightStep) && writeFile.externalFile)
+              modelContent = getExternalFileContent(fileName);
+
+          QStringList *futureContent = new QStringList(writeFile.externalFile ? modelContent : lpub->ldrawFile.contents(fileName));
+          if (Preferences::buildModEnabled)
+              result.smiContent = gui->getModelFileContent(futureContent, fileName);
+          QStringList *cleanContent = new QStringList(gui->writeToTmp(fileName, *futureContent, true/*parseContent*/, &result.lineTypeIndexes));
+
+          if (!writeFile.displayModel) {
+              QString const extension = QFileInfo(fileName).suffix().toLower();
+              QString fadeFileNameStr, highlightFileNameStr;
+
+              if (Gui::doFadeStep) {
+                  if (extension.isEmpty())
+                    fadeFileNameStr = QString(fileName).append(QString("%1.ldr").arg(FADE_SFX));
+                  else
+                    fadeFileNameStr = QString(fileName).replace("."+extension, QString("%1.%2").arg(FADE_SFX, extension));
+                  emit gui->messageSig(LOG_INFO, tr("Writing %1'%2' to temp folder...").arg(fileType, fadeFileNameStr));
+                  QStringList const fadeContent = Gui::configureModelSubFile(*cleanContent, fadeColor, FADE_PART);
+                  result.configuredSubFiles.append(qMakePair(fadeFileNameStr, fadeContent));
+                  gui->writeToTmp(fadeFileNameStr, fadeContent, false/*parseContent*/);
+              }
 
-                  if (Gui::doHighlightStep) {
-                      if (extension.isEmpty())
-                        highlightFileNameStr = QString(fileName).append(QString("%1.ldr").arg(HIGHLIGHT_SFX));
-                      else
-                        highlightFileNameStr = QString(fileName).replace("."+extension, QString("%1.%2").arg(HIGHLIGHT_SFX, extension));
-                      emit gui->messageSig(LOG_INFO, tr("Writing %1'%2' to temp folder...").arg(fileType, highlightFileNameStr));
-                      QStringList *highlightContent = new QStringList(Gui::configureModelSubFile(*cleanContent, fadeColor, HIGHLIGHT_PART));
-                      gui->insertConfiguredSubFile(highlightFileNameStr, *highlightContent);
-                      gui->writeToTmp(highlightFileNameStr, *highlightContent, false/*parseContent*/);
-                  }
+              if (Gui::doHighlightStep) {
+                  if (extension.isEmpty())
+                    highlightFileNameStr = QString(fileName).append(QString("%1.ldr").arg(HIGHLIGHT_SFX));
+                  else
+                    highlightFileNameStr = QString(fileName).replace("."+extension, QString("%1.%2").arg(HIGHLIGHT_SFX, extension));
+                  emit gui->messageSig(LOG_INFO, tr("Writing %1'%2' to temp folder...").arg(fileType, highlightFileNameStr));
+                  QStringList const highlightContent = Gui::configureModelSubFile(*cleanContent, fadeColor, HIGHLIGHT_PART);
+                  result.configuredSubFiles.append(qMakePair(highlightFileNameStr, highlightContent));
+                  gui->writeToTmp(highlightFileNameStr, highlightContent, false/*parseContent*/);
               }
+          }
 
-              delete futureContent;
-              delete cleanContent;
-          }));
-      } // ChangedSinceLastWrite
-  } // Parse _subFileOrder
+          delete futureContent;
+          delete cleanContent;
+
+          result.elapsed = writeFileTimer.elapsed();
+          if (!Gui::ContinuousPage())
+              emit gui->messageSig(LOG_INFO, tr("Wrote %1'%2' to temp folder. %3")
+                                                .arg(fileType, fileName, Gui::elapsedTime(result.elapsed)));
+
+          return result;
+      }));
+  }
+
+  // every thread is finished before LDrawFile is updated, also when aborting
+  for (int i = 0; i < writeToTmpFutures.size(); i++) {
+      WriteToTmpResult result = writeToTmpFutures[i].result();
+      if (Gui::abortProcess())
+          continue;
 
-  for (QFuture<void> &future : writeToTmpFutures)
-      if (!Gui::abortProcess())
-          future.waitForFinished();
+      const QString &fileName = writeToTmpFiles.at(i).fileName;
+      if (result.smiContent.size())
+          lpub->ldrawFile.setSmiContent(fileName, result.smiContent);
+      for (QHash<int, QVector<int> >::iterator it = result.lineTypeIndexes.begin(); it != result.lineTypeIndexes.end(); ++it)
+          lpub->ldrawFile.setLineTypeRelativeIndexes(it.key(), it.value());
+      for (QPair<QString, QStringList> &configuredSubFile : result.configuredSubFiles)
+          gui->insertConfiguredSubFile(configuredSubFile.first, configuredSubFile.second);
+
+      writeToTmpFileTime += result.elapsed;
+  }
 
   writeToTmpFutures.clear();
 
@@ -6569,26 +7202,17 @@ void Gui::writeToTmp()
                                                .arg(writtenFiles ? QString::number(writtenFiles) : tr("No"),
                                                     writtenFiles == 1 ? tr("file") : tr("files"),
                                                     writtenFiles ? writeToTmpElapsedTime : QString()));
+      if (writtenFiles > 1)
+          emit gui->messageSig(LOG_INFO, tr("Cumulative file write time %1 across %2 concurrent files.")
+                                            .arg(Gui::elapsedTime(writeToTmpFileTime, false))
+                                            .arg(writtenFiles));
   }
 
   Gui::revertPageProcess();
 }
 
-void Gui::writeSmiContent(QStringList *content, const QString &fileName)
-{
-    if (! Preferences::buildModEnabled)
-        return;
-
-    QStringList smiContent = getModelFileContent(content, fileName);
-
-    if (smiContent.size())
-        lpub->ldrawFile.setSmiContent(fileName, smiContent);
-}
-
 QStringList Gui::getModelFileContent(QStringList *content, const QString &fileName)
 {
-    QMutexLocker writeLocker(&writeMutex);
-
     Where top(fileName, 0);
 
     gui->skipHeader(top);
@@ -291,7 +291,7 @@ bool Gui::stepContains(Where &topOfStep, const QString &value)
 }
 
 // general case regex
-bool Gui::stepContains(Where &topOfStep, QRegularExpression &lineRx, bool displayModel)
+bool Gui::stepContains(Where &topOfStep, const QRegularExpression &lineRx, bool displayModel)
 {
   bool found = false;
   Where walk = topOfStep;
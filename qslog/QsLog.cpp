@@ -32,6 +32,7 @@
 #endif
 #include <QMutex>
 #include <QVector>
+#include <QVarLengthArray>
 #include <QDateTime>
 #include <QLatin1String>
 #include <QtGlobal>
@@ -583,15 +584,26 @@ namespace QsLogging
   //! it's useful for processing in the destination.
   void Logger::write(const QString& colourMessage, const QString &plainMessage, Level level)
   {
-    QMutexLocker lock(&d->logMutex);
-    for (DestinationList::iterator it = d->destList.begin(),
-         endIt = d->destList.end();it != endIt;++it) {
-        //if console, do not write status level
-        if ((*it)->type() != "file" && level != StatusLevel)
-          (*it)->write(colourMessage, level);
-        else if ((*it)->type() == "file")
-          (*it)->write(plainMessage, level);
-      }
+    // asynchronous file destinations queue without locking, so they are
+    // written after the mutex is released and a full queue cannot stall
+    // the other threads waiting for it
+    QVarLengthArray<DestinationPtr, 2> asyncDestinations;
+    {
+      QMutexLocker lock(&d->logMutex);
+      for (DestinationList::iterator it = d->destList.begin(),
+           endIt = d->destList.end();it != endIt;++it) {
+          const QString type = (*it)->type();
+          if (type == "asyncfile")
+            asyncDestinations.append(*it);
+          //if console, do not write status level
+          else if (type != "file" && level != StatusLevel)
+            (*it)->write(colourMessage, level);
+          else if (type == "file")
+            (*it)->write(plainMessage, level);
+        }
+    }
+    for (const DestinationPtr &destination : asyncDestinations)
+      destination->write(plainMessage, level);
   }
 
   Level Logger::fromLevelString(const QString& string, bool* conversionSucceeded)
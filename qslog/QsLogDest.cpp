@@ -52,6 +52,24 @@ DestinationPtr DestinationFactory::MakeFileDestination(const QString& filePath,
     return DestinationPtr(new FileDestination(filePath, RotationStrategyPtr(new NullRotationStrategy)));
 }
 
+DestinationPtr DestinationFactory::MakeAsyncFileDestination(const QString& filePath,
+    LogRotationOption rotation, const MaxSizeBytes &sizeInBytesToRotateAfter,
+    const MaxOldLogCount &oldLogsToKeep, const MaxQueuedMessages &queueSize,
+    LogOverflowOption overflow)
+{
+    if (EnableLogRotation == rotation) {
+        QScopedPointer<SizeRotationStrategy> logRotation(new SizeRotationStrategy);
+        logRotation->setMaximumSizeInBytes(sizeInBytesToRotateAfter.size);
+        logRotation->setBackupCount(oldLogsToKeep.count);
+
+        return DestinationPtr(new AsyncFileDestination(filePath, RotationStrategyPtr(logRotation.take()),
+                                                       queueSize.count, overflow));
+    }
+
+    return DestinationPtr(new AsyncFileDestination(filePath, RotationStrategyPtr(new NullRotationStrategy),
+                                                   queueSize.count, overflow));
+}
+
 DestinationPtr DestinationFactory::MakeDebugOutputDestination()
 {
     return DestinationPtr(new DebugOutputDestination);
@@ -88,6 +88,20 @@ namespace QsLogging
     int count;
   };
 
+  // what an asynchronous file destination does when its message queue is full
+  enum LogOverflowOption
+  {
+    BlockOnOverflow = 0,
+    DropOnOverflow  = 1
+  };
+
+  struct QSLOG_SHARED_OBJECT MaxQueuedMessages
+  {
+    MaxQueuedMessages() : count(8192) {}
+    explicit MaxQueuedMessages(int count_) : count(count_) {}
+    int count;
+  };
+
 
   //! Creates logging destinations/sinks. The caller shares ownership of the destinations with the logger.
   //! After being added to a logger, the caller can discard the pointers.
@@ -98,6 +112,13 @@ namespace QsLogging
                                               LogRotationOption rotation = DisableLogRotation,
                                               const MaxSizeBytes &sizeInBytesToRotateAfter = MaxSizeBytes(),
                                               const MaxOldLogCount &oldLogsToKeep = MaxOldLogCount());
+    // messages are written by a background thread in batches
+    static DestinationPtr MakeAsyncFileDestination(const QString& filePath,
+                                                   LogRotationOption rotation = DisableLogRotation,
+                                                   const MaxSizeBytes &sizeInBytesToRotateAfter = MaxSizeBytes(),
+                                                   const MaxOldLogCount &oldLogsToKeep = MaxOldLogCount(),
+                                                   const MaxQueuedMessages &queueSize = MaxQueuedMessages(),
+                                                   LogOverflowOption overflow = BlockOnOverflow);
     static DestinationPtr MakeDebugOutputDestination();
     // takes a pointer to a function
     static DestinationPtr MakeFunctorDestination(Destination::LogFunction f);
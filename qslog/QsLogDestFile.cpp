@@ -150,6 +150,7 @@ const char* const QsLogging::FileDestination::Type = "file";
 
 QsLogging::FileDestination::FileDestination(const QString& filePath, RotationStrategyPtr rotationStrategy)
     : mRotationStrategy(rotationStrategy)
+    , mAutoFlush(true)
 {
     mFile.setFileName(filePath);
     if (!mFile.open(QFile::WriteOnly | QFile::Text | mRotationStrategy->recommendedOpenModeFlag())) {
@@ -185,6 +186,17 @@ void QsLogging::FileDestination::write(const QString& message, Level)
     }
 
     mOutputStream << message << QString("\n");
+    if (mAutoFlush)
+        mOutputStream.flush();
+}
+
+void QsLogging::FileDestination::setAutoFlush(bool autoFlush)
+{
+    mAutoFlush = autoFlush;
+}
+
+void QsLogging::FileDestination::flush()
+{
     mOutputStream.flush();
 }
 
@@ -198,3 +210,177 @@ QString QsLogging::FileDestination::type() const
     return QString::fromLatin1(Type);
 }
 
+
+const char* const QsLogging::AsyncFileDestination::Type = "asyncfile";
+const int QsLogging::AsyncFileDestination::FlushIntervalMs = 200;
+const int QsLogging::AsyncFileDestination::BatchSize = 256;
+
+// the ring indices wrap at 2^32, a power of two size keeps index % size continuous
+static quint32 ringSize(int capacity)
+{
+    quint32 size = static_cast<quint32>(QsLogging::AsyncFileDestination::BatchSize);
+    while (size < static_cast<quint32>(capacity) && size < (1u << 30))
+        size <<= 1;
+    return size;
+}
+
+// Atomics use the acquire/release and ordered calls and the writer is a QThread
+// subclass so the destination builds with Qt versions older than 5.14
+class QsLogging::AsyncFileDestination::WriterThread : public QThread
+{
+public:
+    explicit WriterThread(AsyncFileDestination *destination)
+        : mDestination(destination)
+    {
+    }
+
+protected:
+    void run() override
+    {
+        mDestination->run();
+    }
+
+private:
+    AsyncFileDestination *mDestination;
+};
+
+QsLogging::AsyncFileDestination::AsyncFileDestination(const QString& filePath, RotationStrategyPtr rotationStrategy,
+                                                      int capacity, LogOverflowOption overflow)
+    : mFile(filePath, rotationStrategy)
+    , mRing(ringSize(capacity))
+    , mCapacity(static_cast<quint32>(mRing.size()))
+    , mOverflow(overflow)
+    , mHead(0)
+    , mTail(0)
+    , mDropped(0)
+    , mDroppedReported(0)
+    , mStopping(0)
+{
+    for (quint32 index = 0; index < mCapacity; ++index)
+        mRing[index].sequence.storeRelease(index);
+
+    mFile.setAutoFlush(false);
+    mThread.reset(new WriterThread(this));
+    mThread->setObjectName(QLatin1String("QsLogFileWriter"));
+    mThread->start(QThread::LowPriority);
+}
+
+QsLogging::AsyncFileDestination::~AsyncFileDestination()
+{
+    mStopping.storeRelease(1);
+    mMessagesQueued.wakeAll();
+    mThread->wait();
+}
+
+void QsLogging::AsyncFileDestination::write(const QString& message, Level level)
+{
+    quint32 tail = mTail.loadAcquire();
+    Slot *slot;
+
+    // claim the slot at the tail, another writer may take it first
+    for (;;) {
+        slot = &mRing[tail % mCapacity];
+        const qint32 distance = static_cast<qint32>(slot->sequence.loadAcquire() - tail);
+
+        if (distance == 0) {
+            if (mTail.testAndSetRelaxed(tail, tail + 1, tail))
+                break;
+        } else if (distance < 0) {
+            // the writer thread has not written this slot yet, the ring is full
+            if (mOverflow == DropOnOverflow) {
+                mDropped.fetchAndAddOrdered(1);
+                return;
+            }
+
+            QMutexLocker locker(&mMutex);
+            mMessagesQueued.wakeOne();
+            mSpaceAvailable.wait(&mMutex, 10);
+            tail = mTail.loadAcquire();
+        } else {
+            tail = mTail.loadAcquire();
+        }
+    }
+
+    slot->message = message;
+    slot->sequence.storeRelease(tail + 1);
+
+    if (level >= ErrorLevel) {
+        // error and fatal messages are on disk before write returns so a crash does not lose them
+        QMutexLocker locker(&mMutex);
+        while (static_cast<qint32>(mHead.loadAcquire() - (tail + 1)) < 0 && !mStopping.loadAcquire()) {
+            mMessagesQueued.wakeOne();
+            mSpaceAvailable.wait(&mMutex, 10);
+        }
+    } else if (tail + 1 - mHead.loadAcquire() == static_cast<quint32>(BatchSize)) {
+        mMessagesQueued.wakeOne();
+    }
+}
+
+bool QsLogging::AsyncFileDestination::isValid()
+{
+    return mFile.isValid();
+}
+
+QString QsLogging::AsyncFileDestination::type() const
+{
+    return QString::fromLatin1(Type);
+}
+
+quint32 QsLogging::AsyncFileDestination::droppedMessages() const
+{
+    return mDropped.loadAcquire();
+}
+
+// Writes every queued message, returns false if the queue was empty.
+// Stops at the first slot whose writer has claimed but not yet filled it.
+bool QsLogging::AsyncFileDestination::drain()
+{
+    const quint32 head = mHead.loadAcquire();
+
+    if (mRing[head % mCapacity].sequence.loadAcquire() != head + 1)
+        return false;
+
+    const quint32 dropped = mDropped.loadAcquire();
+    if (dropped != mDroppedReported) {
+        mFile.write(QString::fromLatin1("QsLog: %1 messages dropped, the log queue was full").arg(dropped - mDroppedReported), WarningLevel);
+        mDroppedReported = dropped;
+    }
+
+    quint32 index = head;
+    for (; index != head + mCapacity; ++index) {
+        Slot &slot = mRing[index % mCapacity];
+        if (slot.sequence.loadAcquire() != index + 1)
+            break;
+        mFile.write(slot.message, InfoLevel);
+        slot.message.clear();
+        slot.sequence.storeRelease(index + mCapacity);
+    }
+
+    // flush before the head moves, error messages wait for the head to pass them
+    mFile.flush();
+    mHead.storeRelease(index);
+    mSpaceAvailable.wakeAll();
+
+    return true;
+}
+
+void QsLogging::AsyncFileDestination::run()
+{
+    for (;;) {
+        if (!drain()) {
+            if (mStopping.loadAcquire())
+                break;
+
+            QMutexLocker locker(&mMutex);
+            if (mTail.loadAcquire() == mHead.loadAcquire() && !mStopping.loadAcquire())
+                mMessagesQueued.wait(&mMutex, FlushIntervalMs);
+            continue;
+        }
+
+        // let a partial batch collect before the next write
+        if (!mStopping.loadAcquire() && mTail.loadAcquire() - mHead.loadAcquire() < static_cast<quint32>(BatchSize)) {
+            QMutexLocker locker(&mMutex);
+            mMessagesQueued.wait(&mMutex, FlushIntervalMs);
+        }
+    }
+}
@@ -27,10 +27,16 @@
 #define QSLOGDESTFILE_H
 
 #include "QsLogDest.h"
+#include <QAtomicInteger>
 #include <QFile>
+#include <QMutex>
+#include <QScopedPointer>
 #include <QTextStream>
+#include <QThread>
+#include <QWaitCondition>
 #include <QtGlobal>
 #include <QSharedPointer>
+#include <vector>
 
 namespace QsLogging
 {
@@ -100,10 +106,66 @@ public:
     virtual bool isValid();
     virtual QString type() const;
 
+    // when disabled, messages stay in the stream buffer until flush() is called
+    void setAutoFlush(bool autoFlush);
+    void flush();
+
 private:
     QFile mFile;
     QTextStream mOutputStream;
     QSharedPointer<RotationStrategy> mRotationStrategy;
+    bool mAutoFlush;
+};
+
+// file message sink that hands messages to a background writer thread.
+// Messages are queued in a ring buffer and written in batches that are
+// flushed when the queue is drained, at most every FlushIntervalMs. Error and
+// fatal messages are written and flushed before write returns.
+// Any number of threads may write; they claim ring slots without locking and
+// Logger::write calls this destination outside its log mutex.
+class AsyncFileDestination : public Destination
+{
+public:
+    static const char* const Type;
+    static const int FlushIntervalMs;
+    static const int BatchSize;
+
+    AsyncFileDestination(const QString& filePath, RotationStrategyPtr rotationStrategy,
+                         int capacity, LogOverflowOption overflow);
+    virtual ~AsyncFileDestination();
+    virtual void write(const QString& message, Level level);
+    virtual bool isValid();
+    virtual QString type() const;
+
+    quint32 droppedMessages() const;
+
+private:
+    class WriterThread;
+
+    void run();
+    bool drain();
+
+    // a slot is free for message number n when its sequence is n and
+    // holds that message once its sequence is n + 1
+    struct Slot
+    {
+        QAtomicInteger<quint32> sequence;
+        QString message;
+    };
+
+    FileDestination mFile;
+    std::vector<Slot> mRing;
+    const quint32 mCapacity;
+    const LogOverflowOption mOverflow;
+    QAtomicInteger<quint32> mHead;
+    QAtomicInteger<quint32> mTail;
+    QAtomicInteger<quint32> mDropped;
+    quint32 mDroppedReported;
+    QAtomicInt mStopping;
+    QMutex mMutex;
+    QWaitCondition mMessagesQueued;
+    QWaitCondition mSpaceAvailable;
+    QScopedPointer<QThread> mThread;
 };
 
 }